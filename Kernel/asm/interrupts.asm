@@ -15,12 +15,24 @@ GLOBAL _irq01Handler
 GLOBAL _int80Handler
 GLOBAL _yieldHandler
 
+GLOBAL _syscallHandler
+GLOBAL _syscallInit
+
+GLOBAL _apicTimerHandler
+GLOBAL _rescheduleHandler
+GLOBAL _apStartHandler
+
 GLOBAL _exception0Handler
 
 EXTERN irqDispatcher
 EXTERN intDispatcher
+EXTERN syscallDispatcher
 EXTERN exceptionDispatcher
 EXTERN schedule
+EXTERN kernel_lock
+EXTERN kernel_unlock
+EXTERN lapic_eoi
+EXTERN smp_ap_start
 
 SECTION .text
 
@@ -60,26 +72,9 @@ SECTION .text
 	pop r15
 %endmacro
 
-%macro popStateWithoutRax 0
-	add rsp, 8
-	pop rbx
-	pop rcx
-	pop rdx
-	pop rbp
-	pop rdi
-	pop rsi
-	pop r8
-	pop r9
-	pop r10
-	pop r11
-	pop r12
-	pop r13
-	pop r14
-	pop r15
-%endmacro
-
 %macro irqHandlerMaster 1
 	pushState
+	call kernel_lock
 
 	mov rdi, %1
 	mov rsi, rsp
@@ -89,17 +84,36 @@ SECTION .text
 	mov al, 20h
 	out 20h, al
 
+	call kernel_unlock
 	popState
 	iretq
 %endmacro
 
 %macro intHandlerMaster 0
 	pushState
+	call kernel_lock
+
 	mov rdi, rsp
 	;sti
 	call intDispatcher
 
-	popStateWithoutRax
+	mov [rsp], rax
+	call kernel_unlock
+	popState
+	iretq
+%endmacro
+
+%macro apicScheduleHandler 0
+	pushState
+	call kernel_lock
+
+	mov rdi, rsp
+	call schedule
+	mov rsp, rax
+
+	call lapic_eoi
+	call kernel_unlock
+	popState
 	iretq
 %endmacro
 
@@ -149,6 +163,7 @@ picSlaveMask:
 
 _irq00Handler:
 	pushState
+	call kernel_lock
 
 	mov rdi, 0
 	mov rsi, rsp
@@ -163,6 +178,7 @@ _irq00Handler:
 	mov al, 20h
 	out 20h, al
 
+	call kernel_unlock
 	popState
 	iretq
 
@@ -174,6 +190,68 @@ _int80Handler:
 	intHandlerMaster
 
 
+; SYSCALL entry. Callers are libc wrappers, so only the return rip/rflags
+; (rcx/r11) and the argument registers clobbered by kernel_lock are saved.
+_syscallHandler:
+	push rcx
+	push r11
+	sub rsp, 8
+	push rax
+
+	push rdi
+	push rsi
+	push rdx
+	push r10
+	push r8
+	push r9
+	call kernel_lock
+	pop r9
+	pop r8
+	pop rcx
+	pop rdx
+	pop rsi
+	pop rdi
+
+	call syscallDispatcher
+
+	mov [rsp], rax
+	call kernel_unlock
+	pop rax
+	add rsp, 8
+	pop r11
+	pop rcx
+
+	push r11
+	popfq
+	jmp rcx
+
+
+_syscallInit:
+	mov ecx, 0xC0000080		; EFER: enable SYSCALL
+	rdmsr
+	or eax, 1
+	wrmsr
+
+	mov ecx, 0xC0000081		; STAR: CS 0x08, SS 0x10
+	xor eax, eax
+	mov edx, 0x08
+	wrmsr
+
+	mov ecx, 0xC0000082		; LSTAR: entry point
+	mov rax, _syscallHandler
+	mov rdx, rax
+	shr rdx, 32
+	wrmsr
+
+	mov ecx, 0xC0000084		; SFMASK: clear IF and DF on entry
+	mov eax, 0x600
+	xor edx, edx
+	wrmsr
+	ret
+
+
+; Reached from yield(), which holds the kernel lock. Like every other epilogue it
+; releases the lock before resuming, and yield() takes it again on return.
 _yieldHandler:
 	pushState
 
@@ -182,6 +260,25 @@ _yieldHandler:
 	call schedule
 	mov rsp, rax
 
+	call kernel_unlock
+	popState
+	iretq
+
+
+_apicTimerHandler:
+	apicScheduleHandler
+
+
+_rescheduleHandler:
+	apicScheduleHandler
+
+
+_apStartHandler:
+	pushState
+
+	call smp_ap_start
+	call lapic_eoi
+
 	popState
 	iretq
 
@@ -211,7 +308,7 @@ _initialize_stack_frame:
 
 	push 0x0
 	push rdx
-	push 0x202
+	push 0x002
 	push 0x8
 	push rdi
 
@@ -1,6 +1,8 @@
 GLOBAL inb
 GLOBAL outb
 GLOBAL _xchg
+GLOBAL _cmpxchg
+GLOBAL _xadd
 
 section .text
 	
@@ -24,5 +26,17 @@ _xchg:
   xchg [rdi], eax
   ret
 
+; Returns the value found in [rdi]; the swap happened iff it equals esi.
+_cmpxchg:
+  mov eax, esi
+  lock cmpxchg [rdi], edx
+  ret
+
+; Returns the value [rdi] held before adding esi.
+_xadd:
+  mov eax, esi
+  lock xadd [rdi], eax
+  ret
+
 
 section .note.GNU-stack noalloc noexec nowrite progbits
\ No newline at end of file
@@ -0,0 +1,138 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+
+#include <stdint.h>
+#include <apic.h>
+#include <lib.h>
+#include <hpet.h>
+
+#define LAPIC_ADDRESS_PTR ((uint64_t *)0x5A28)
+
+#define LAPIC_ID 0x020
+#define LAPIC_EOI 0x0B0
+#define LAPIC_ICR_LOW 0x300
+#define LAPIC_ICR_HIGH 0x310
+#define LAPIC_LVT_TIMER 0x320
+#define LAPIC_TIMER_INITIAL 0x380
+#define LAPIC_TIMER_CURRENT 0x390
+#define LAPIC_TIMER_DIVIDE 0x3E0
+
+#define ICR_DELIVERY_PENDING (1 << 12)
+#define ICR_LEVEL_ASSERT (1 << 14)
+#define LVT_MASKED (1 << 16)
+#define LVT_TIMER_PERIODIC (1 << 17)
+#define TIMER_DIVIDE_BY_16 0x3
+
+#define PIT_FREQUENCY 1193182
+#define PIT_CHANNEL2_DATA 0x42
+#define PIT_COMMAND 0x43
+#define PIT_CHANNEL2_GATE 0x61
+#define CALIBRATION_HZ 100
+#define CALIBRATION_NS (1000000000ULL / CALIBRATION_HZ)
+
+static volatile uint32_t *lapic = 0;
+static uint32_t ticks_per_calibration = 0;
+
+static inline uint32_t lapic_read(uint32_t reg)
+{
+    return lapic[reg / sizeof(uint32_t)];
+}
+
+static inline void lapic_write(uint32_t reg, uint32_t value)
+{
+    lapic[reg / sizeof(uint32_t)] = value;
+}
+
+void lapic_init(void)
+{
+    lapic = (volatile uint32_t *)*LAPIC_ADDRESS_PTR;
+}
+
+uint8_t lapic_is_present(void)
+{
+    return lapic != 0;
+}
+
+uint64_t lapic_get_address(void)
+{
+    return (uint64_t)lapic;
+}
+
+uint8_t lapic_get_id(void)
+{
+    if (!lapic)
+        return 0;
+    return (uint8_t)(lapic_read(LAPIC_ID) >> 24);
+}
+
+void lapic_eoi(void)
+{
+    lapic_write(LAPIC_EOI, 0);
+}
+
+void lapic_send_ipi(uint8_t apic_id, uint8_t vector)
+{
+    lapic_write(LAPIC_ICR_HIGH, (uint32_t)apic_id << 24);
+    lapic_write(LAPIC_ICR_LOW, ICR_LEVEL_ASSERT | vector);
+
+    while (lapic_read(LAPIC_ICR_LOW) & ICR_DELIVERY_PENDING)
+        __asm__ volatile("pause");
+}
+
+static void pit_calibration_wait(void)
+{
+    uint16_t pit_count = PIT_FREQUENCY / CALIBRATION_HZ;
+
+    uint8_t gate = (inb(PIT_CHANNEL2_GATE) & 0xFD) | 0x01;
+    outb(PIT_CHANNEL2_GATE, gate);
+    outb(PIT_COMMAND, 0xB0);
+    outb(PIT_CHANNEL2_DATA, pit_count & 0xFF);
+    outb(PIT_CHANNEL2_DATA, pit_count >> 8);
+
+    gate = inb(PIT_CHANNEL2_GATE) & 0xFE;
+    outb(PIT_CHANNEL2_GATE, gate);
+    outb(PIT_CHANNEL2_GATE, gate | 0x01);
+    lapic_write(LAPIC_TIMER_INITIAL, 0xFFFFFFFF);
+
+    while (!(inb(PIT_CHANNEL2_GATE) & 0x20))
+        ;
+}
+
+static void hpet_calibration_wait(void)
+{
+    uint64_t start = hpet_nanoseconds();
+    lapic_write(LAPIC_TIMER_INITIAL, 0xFFFFFFFF);
+
+    while (hpet_nanoseconds() - start < CALIBRATION_NS)
+        ;
+}
+
+void lapic_calibrate_timer(void)
+{
+    lapic_write(LAPIC_TIMER_DIVIDE, TIMER_DIVIDE_BY_16);
+    lapic_write(LAPIC_LVT_TIMER, LVT_MASKED);
+
+    if (hpet_is_present())
+        hpet_calibration_wait();
+    else
+        pit_calibration_wait();
+
+    ticks_per_calibration = 0xFFFFFFFF - lapic_read(LAPIC_TIMER_CURRENT);
+    lapic_write(LAPIC_TIMER_INITIAL, 0);
+}
+
+void lapic_start_timer(uint32_t hz)
+{
+    uint32_t count = (uint32_t)((uint64_t)ticks_per_calibration * CALIBRATION_HZ / hz);
+
+    lapic_write(LAPIC_TIMER_DIVIDE, TIMER_DIVIDE_BY_16);
+    lapic_write(LAPIC_LVT_TIMER, LVT_TIMER_PERIODIC | LAPIC_TIMER_VECTOR);
+    lapic_write(LAPIC_TIMER_INITIAL, count);
+}
+
+void lapic_stop_timer(void)
+{
+    lapic_write(LAPIC_LVT_TIMER, LVT_MASKED);
+    lapic_write(LAPIC_TIMER_INITIAL, 0);
+}
@@ -0,0 +1,73 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+
+#include <stdint.h>
+#include <hpet.h>
+
+#define HPET_ADDRESS_PTR ((uint64_t *)0x5A38)
+
+#define HPET_CAPABILITIES 0x000
+#define HPET_CONFIG 0x010
+#define HPET_MAIN_COUNTER 0x0F0
+
+#define HPET_ENABLE_CNF 0x1
+#define FEMTOSECONDS_PER_NANOSECOND 1000000
+
+static volatile uint64_t *hpet = 0;
+static uint64_t period_fs = 0;
+
+static inline uint64_t hpet_read(uint32_t reg)
+{
+    return hpet[reg / sizeof(uint64_t)];
+}
+
+static inline void hpet_write(uint32_t reg, uint64_t value)
+{
+    hpet[reg / sizeof(uint64_t)] = value;
+}
+
+void hpet_init(void)
+{
+    uint64_t address = *HPET_ADDRESS_PTR;
+    if (address == 0)
+        return;
+
+    hpet = (volatile uint64_t *)address;
+    period_fs = hpet_read(HPET_CAPABILITIES) >> 32;
+
+    if (period_fs == 0)
+    {
+        hpet = 0;
+        return;
+    }
+
+    hpet_write(HPET_CONFIG, hpet_read(HPET_CONFIG) | HPET_ENABLE_CNF);
+}
+
+uint8_t hpet_is_present(void)
+{
+    return hpet != 0;
+}
+
+uint64_t hpet_nanoseconds(void)
+{
+    if (!hpet)
+        return 0;
+
+    // Split to avoid overflowing counter * period (about 10^8 fs per tick).
+    uint64_t counter = hpet_read(HPET_MAIN_COUNTER);
+    uint64_t whole = (counter / FEMTOSECONDS_PER_NANOSECOND) * period_fs;
+    uint64_t rest = (counter % FEMTOSECONDS_PER_NANOSECOND) * period_fs / FEMTOSECONDS_PER_NANOSECOND;
+    return whole + rest;
+}
+
+uint64_t hpet_get_address(void)
+{
+    return (uint64_t)hpet;
+}
+
+uint64_t hpet_get_period_fs(void)
+{
+    return period_fs;
+}
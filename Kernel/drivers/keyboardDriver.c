@@ -9,6 +9,9 @@
 #include <semaphores.h>
 #include <scheduler.h>
 #include <consoleDriver.h>
+#include <keyboardDriver.h>
+#include <poll.h>
+#include <list.h>
 
 extern void kill_foreground_process(void);
 
@@ -117,11 +120,14 @@ typedef struct
 static kbd_state_t kbd_state = {0};
 
 static sem_t kbd_semaphore = 0;
+static List kbd_poll_queue;
 
 void init_keyboard(void)
 {
 
     sem_init(&kbd_semaphore, 0);
+    sem_set_block_reason(&kbd_semaphore, BLOCK_KEYBOARD);
+    list_init(&kbd_poll_queue);
 }
 
 static inline uint8_t has_buffer_space(void)
@@ -141,6 +147,7 @@ static inline void insert_char(char c)
     kbd_state.count++;
 
     sem_post(&kbd_semaphore);
+    poll_notify(&kbd_poll_queue);
 }
 
 static inline char extract_char(void)
@@ -211,7 +218,7 @@ void keyboard_handler(const registers_t *registers)
 
                 if (has_buffer_space())
                 {
-                    insert_char(-1);
+                    insert_char(KEYBOARD_EOF);
                 }
                 return;
             }
@@ -240,4 +247,18 @@ char getCharBlocking(void)
     sem_wait(&kbd_semaphore);
 
     return extract_char();
-}
\ No newline at end of file
+}
+
+uint8_t keyboard_poll(uint8_t events, PollWaiter *waiter)
+{
+    if ((events & POLLIN) && !is_buffer_empty())
+    {
+        return POLLIN;
+    }
+
+    if (waiter != NULL)
+    {
+        poll_wait_on(waiter, &kbd_poll_queue);
+    }
+    return 0;
+}
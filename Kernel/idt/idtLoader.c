@@ -5,6 +5,7 @@
 #include <stdint.h>
 #include <idtLoader.h>
 #include <interrupts.h>
+#include <apic.h>
 
 #define ACS_INT 0x8E
 
@@ -41,6 +42,11 @@ void load_idt()
   setup_IDT_entry(IRQ1_ID, (uint64_t)&_irq01Handler);
   setup_IDT_entry(SYSCALL_ID, (uint64_t)&_int80Handler);
   setup_IDT_entry(YIELD_ID, (uint64_t)&_yieldHandler);
+  setup_IDT_entry(LAPIC_TIMER_VECTOR, (uint64_t)&_apicTimerHandler);
+  setup_IDT_entry(RESCHEDULE_VECTOR, (uint64_t)&_rescheduleHandler);
+  setup_IDT_entry(AP_START_VECTOR, (uint64_t)&_apStartHandler);
+
+  _syscallInit();
 
   picMasterMask(PIC_MASTER_MASK_VALUE);
   picSlaveMask(PIC_SLAVE_MASK_VALUE);
@@ -6,6 +6,7 @@
 #include <syscalls.h>
 #include <videoDriver.h>
 #include <keyboardDriver.h>
+#include <scheduler.h>
 #include <stddef.h>
 
 static uint64_t (*intHandlers[])(uint64_t rdi, uint64_t rsi, uint64_t rdx, uint64_t rcx, uint64_t r8, uint64_t r9) = {
@@ -22,6 +23,7 @@ static uint64_t (*intHandlers[])(uint64_t rdi, uint64_t rsi, uint64_t rdx, uint6
     [SYSCALL_MALLOC] = sys_malloc,
     [SYSCALL_FREE] = sys_free,
     [SYSCALL_MEM_STATE] = sys_mem_state,
+    [SYSCALL_GET_KMEM_INFO] = sys_get_kmem_info,
     [SYSCALL_SEM_INIT] = sys_sem_init,
     [SYSCALL_SEM_OPEN] = sys_sem_open,
     [SYSCALL_SEM_CLOSE] = sys_sem_close,
@@ -32,24 +34,63 @@ static uint64_t (*intHandlers[])(uint64_t rdi, uint64_t rsi, uint64_t rdx, uint6
     [SYSCALL_PIPE_OPEN] = sys_pipe_open,
     [SYSCALL_PIPE_CLOSE] = sys_pipe_close,
     [SYSCALL_PIPE_GET] = sys_pipe_get,
+    [SYSCALL_PIPE_CREATE] = sys_pipe_create,
+    [SYSCALL_POLL] = sys_poll,
+    [SYSCALL_SET_FD_FLAGS] = sys_set_fd_flags,
+    [SYSCALL_SPLICE] = sys_splice,
+    [SYSCALL_TEE] = sys_tee,
+    [SYSCALL_SHM_CREATE] = sys_shm_create,
+    [SYSCALL_SHM_ATTACH] = sys_shm_attach,
+    [SYSCALL_SHM_DETACH] = sys_shm_detach,
+    [SYSCALL_SHM_DESTROY] = sys_shm_destroy,
+    [SYSCALL_MQ_CREATE] = sys_mq_create,
+    [SYSCALL_MQ_DESTROY] = sys_mq_destroy,
+    [SYSCALL_MQ_SEND] = sys_mq_send,
+    [SYSCALL_MQ_RECEIVE] = sys_mq_receive,
+    [SYSCALL_FUTEX_WAIT] = sys_futex_wait,
+    [SYSCALL_FUTEX_WAKE] = sys_futex_wake,
+    [SYSCALL_SEM_TRYWAIT] = sys_sem_trywait,
+    [SYSCALL_SEM_TIMEDWAIT] = sys_sem_timedwait,
+    [SYSCALL_SEM_INIT_MUTEX] = sys_sem_init_mutex,
+    [SYSCALL_RWLOCK_CREATE] = sys_rwlock_create,
+    [SYSCALL_RWLOCK_DESTROY] = sys_rwlock_destroy,
+    [SYSCALL_RWLOCK_LOCK] = sys_rwlock_lock,
+    [SYSCALL_RWLOCK_UNLOCK] = sys_rwlock_unlock,
+    [SYSCALL_COND_CREATE] = sys_cond_create,
+    [SYSCALL_COND_DESTROY] = sys_cond_destroy,
+    [SYSCALL_COND_WAIT] = sys_cond_wait,
+    [SYSCALL_COND_SIGNAL] = sys_cond_signal,
+    [SYSCALL_COND_BROADCAST] = sys_cond_broadcast,
+    [SYSCALL_BARRIER_CREATE] = sys_barrier_create,
+    [SYSCALL_BARRIER_DESTROY] = sys_barrier_destroy,
+    [SYSCALL_BARRIER_WAIT] = sys_barrier_wait,
     [SYSCALL_GET_PROCESS_INFO] = sys_get_process_info,
+    [SYSCALL_TRACE_DRAIN] = sys_trace_drain,
     [SYSCALL_SLEEP] = sys_sleep,
+    [SYSCALL_GET_TICKS] = sys_get_ticks,
+    [SYSCALL_GET_TIME_NS] = sys_get_time_ns,
+    [SYSCALL_SLEEP_MS] = sys_sleep_ms,
+    [SYSCALL_NANOSLEEP] = sys_nanosleep,
 };
 
-uint64_t intDispatcher(const registers_t *registers)
+uint64_t syscallDispatcher(uint64_t rdi, uint64_t rsi, uint64_t rdx, uint64_t rcx, uint64_t r8, uint64_t r9, uint64_t syscall_num)
 {
-    uint64_t syscall_num = registers->rax;
+    // Blocked or killed from another CPU while waiting for the kernel lock.
+    if (get_current_process()->status != RUNNING)
+    {
+        yield();
+    }
 
     if (syscall_num < sizeof(intHandlers) / sizeof(intHandlers[0]) && intHandlers[syscall_num] != NULL)
     {
-        return intHandlers[syscall_num](
-            registers->rdi,
-            registers->rsi,
-            registers->rdx,
-            registers->rcx,
-            registers->r8,
-            registers->r9);
+        return intHandlers[syscall_num](rdi, rsi, rdx, rcx, r8, r9);
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+uint64_t intDispatcher(const registers_t *registers)
+{
+    return syscallDispatcher(registers->rdi, registers->rsi, registers->rdx,
+                             registers->rcx, registers->r8, registers->r9, registers->rax);
+}
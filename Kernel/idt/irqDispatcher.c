@@ -13,5 +13,9 @@ void irqDispatcher(uint64_t irq, const registers_t *registers)
     if (irq >= sizeof(intHandlers) / sizeof(intHandlers[0]))
         return;
 
+    // Any device interrupt ends a stretched idle tick.
+    if (irq != 0)
+        tick_resume();
+
     intHandlers[irq](registers);
 }
\ No newline at end of file
@@ -8,12 +8,22 @@
 #include <keyboardDriver.h>
 #include <scheduler.h>
 #include <memoryManager.h>
+#include <slab.h>
 #include <semaphores.h>
 #include <lib.h>
 #include <pipe.h>
 #include <time.h>
-#include <rtc.h>
+#include <timer.h>
 #include <interrupts.h>
+#include <poll.h>
+#include <shm.h>
+#include <messageQueue.h>
+#include <futex.h>
+#include <syncObjects.h>
+#include <trace.h>
+
+static int16_t resolve_fd(uint64_t fd);
+static int64_t transfer(uint64_t fd_in, uint64_t fd_out, uint64_t len, uint8_t consume);
 
 uint64_t sys_read(uint64_t fd, uint64_t buf, uint64_t count, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3)
 {
@@ -44,19 +54,19 @@ uint64_t sys_read(uint64_t fd, uint64_t buf, uint64_t count, uint64_t _unused1,
     switch (actual_fd)
     {
     case STDIN:
-        int i = 0;
-        for (i = 0; i < count; i++)
+        if (count == 0)
         {
+            return 0;
+        }
 
-            buffer[i] = getCharBlocking();
-
-            if ((int8_t)buffer[i] == -1)
-            {
-
-                return i + 1;
-            }
+        char c = getCharBlocking();
+        if (c == KEYBOARD_EOF)
+        {
+            return 0;
         }
-        return i;
+
+        buffer[0] = c;
+        return 1;
     default:
         return 0;
     }
@@ -68,24 +78,20 @@ uint64_t sys_write(uint64_t fd, uint64_t buf, uint64_t count, uint64_t _unused1,
 
     int16_t actual_fd = get_process_fd((uint8_t)fd);
 
-    if (actual_fd == -1 && fd < 3)
-    {
-        return 0;
-    }
-
     if (fd >= 3)
     {
         actual_fd = (int16_t)fd;
     }
 
-    if (actual_fd >= BUILT_IN_DESCRIPTORS)
+    // Checked first: an unset standard descriptor is also -1, and both swallow the whole write.
+    if (actual_fd == DEV_NULL)
     {
-        return pipe_write(get_pid(), (uint16_t)actual_fd, buffer, count);
+        return count;
     }
 
-    if (actual_fd == DEV_NULL)
+    if (actual_fd >= BUILT_IN_DESCRIPTORS)
     {
-        return count;
+        return pipe_write((uint16_t)actual_fd, buffer, count);
     }
 
     switch (actual_fd)
@@ -151,7 +157,7 @@ uint64_t sys_set_priority(uint64_t pid, uint64_t new_priority, uint64_t _unused1
 
 uint64_t sys_block(uint64_t pid, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
 {
-    int8_t result = set_status((uint16_t)pid, BLOCKED);
+    int8_t result = block_process((uint16_t)pid, BLOCK_MANUAL);
     return (uint64_t)(int64_t)result;
 }
 
@@ -202,6 +208,13 @@ uint64_t sys_mem_state(uint64_t total_ptr, uint64_t free_ptr, uint64_t used_ptr,
     return 0;
 }
 
+uint64_t sys_get_kmem_info(uint64_t info_array_ptr, uint64_t max_count, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4)
+{
+    KmemCacheInfo *info_array = (KmemCacheInfo *)info_array_ptr;
+    int32_t result = kmem_cache_get_info(info_array, (uint32_t)max_count);
+    return (uint64_t)(int64_t)result;
+}
+
 uint64_t sys_sem_init(uint64_t sem_id, uint64_t initial_value, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4)
 {
     sem_t id = (sem_t)sem_id;
@@ -244,6 +257,27 @@ uint64_t sys_sem_post(uint64_t sem_id, uint64_t _unused1, uint64_t _unused2, uin
     return (uint64_t)(int64_t)result;
 }
 
+uint64_t sys_sem_trywait(uint64_t sem_id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    sem_t id = (sem_t)sem_id;
+    int8_t result = sem_trywait(&id);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_sem_timedwait(uint64_t sem_id, uint64_t timeout_ticks, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4)
+{
+    sem_t id = (sem_t)sem_id;
+    int8_t result = sem_timedwait(&id, timeout_ticks);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_sem_init_mutex(uint64_t sem_id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    sem_t id = (sem_t)sem_id;
+    int8_t result = sem_init_mutex(&id);
+    return (uint64_t)(int64_t)result;
+}
+
 uint64_t sys_waitpid(uint64_t pid, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
 {
     int32_t result = waitpid((uint16_t)pid);
@@ -252,13 +286,13 @@ uint64_t sys_waitpid(uint64_t pid, uint64_t _unused1, uint64_t _unused2, uint64_
 
 uint64_t sys_pipe_open(uint64_t id, uint64_t mode, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4)
 {
-    int8_t result = pipe_open(get_pid(), (uint16_t)id, (uint8_t)mode);
+    int8_t result = pipe_open((uint16_t)id, (uint8_t)mode);
     return (uint64_t)result;
 }
 
-uint64_t sys_pipe_close(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+uint64_t sys_pipe_close(uint64_t id, uint64_t mode, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4)
 {
-    int8_t result = pipe_close(get_pid(), (uint16_t)id);
+    int8_t result = pipe_close((uint16_t)id, (uint8_t)mode);
     return (uint64_t)result;
 }
 
@@ -268,6 +302,36 @@ uint64_t sys_pipe_get(uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, u
     return (uint64_t)result;
 }
 
+uint64_t sys_pipe_create(uint64_t capacity, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    if (capacity > PIPE_MAX_CAPACITY)
+    {
+        capacity = PIPE_MAX_CAPACITY;
+    }
+
+    int16_t result = pipe_create((uint32_t)capacity);
+    return (uint64_t)result;
+}
+
+uint64_t sys_poll(uint64_t fds_ptr, uint64_t count, uint64_t timeout_ticks, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3)
+{
+    int32_t result = poll((PollFd *)fds_ptr, (uint32_t)count, timeout_ticks);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_set_fd_flags(uint64_t fd, uint64_t flags, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4)
+{
+    int16_t actual_fd = resolve_fd(fd);
+
+    if (actual_fd < BUILT_IN_DESCRIPTORS)
+    {
+        return (uint64_t)-1;
+    }
+
+    int8_t result = pipe_set_flags((uint16_t)actual_fd, (uint8_t)flags);
+    return (uint64_t)(int64_t)result;
+}
+
 uint64_t sys_get_process_info(uint64_t info_array_ptr, uint64_t max_count, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4)
 {
     ProcessInfo *info_array = (ProcessInfo *)info_array_ptr;
@@ -275,38 +339,311 @@ uint64_t sys_get_process_info(uint64_t info_array_ptr, uint64_t max_count, uint6
     return (uint64_t)result;
 }
 
+uint64_t sys_trace_drain(uint64_t buffer_ptr, uint64_t max_count, uint64_t dropped_ptr, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3)
+{
+    TraceEvent *buffer = (TraceEvent *)buffer_ptr;
+    if (buffer == NULL && max_count > 0)
+        return (uint64_t)-1;
+
+    uint32_t count = trace_drain(buffer, (uint32_t)max_count, (uint32_t *)dropped_ptr);
+    return (uint64_t)count;
+}
+
 uint64_t sys_sleep(uint64_t seconds, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
 {
+    sleep_current_process(seconds * TICK_HZ);
+    return 0;
+}
+
+uint64_t sys_sleep_ms(uint64_t milliseconds, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    sleep_current_process(ns_to_ticks(milliseconds * 1000000));
+    return 0;
+}
 
-    uint32_t start_seconds = rtc_get_seconds();
-    uint32_t target_seconds = start_seconds + (uint32_t)seconds;
+uint64_t sys_nanosleep(uint64_t nanoseconds, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    sleep_current_process(ns_to_ticks(nanoseconds));
+    return 0;
+}
+
+uint64_t sys_get_ticks(uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5, uint64_t _unused6)
+{
+    return ticks_elapsed();
+}
 
-    if (target_seconds >= 86400)
+uint64_t sys_get_time_ns(uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5, uint64_t _unused6)
+{
+    return nanoseconds_since_boot();
+}
+
+uint64_t sys_splice(uint64_t fd_in, uint64_t fd_out, uint64_t len, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3)
+{
+    return (uint64_t)transfer(fd_in, fd_out, len, 1);
+}
+
+uint64_t sys_tee(uint64_t fd_in, uint64_t fd_out, uint64_t len, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3)
+{
+    return (uint64_t)transfer(fd_in, fd_out, len, 0);
+}
+
+uint64_t sys_shm_create(uint64_t id, uint64_t size, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4)
+{
+    if (id >= MAX_SHM_SEGMENTS || size > MAX_SHM_SIZE)
     {
-        target_seconds -= 86400;
+        return (uint64_t)-1;
     }
 
-    if (target_seconds > start_seconds)
+    int8_t result = shm_create((uint16_t)id, (uint32_t)size);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_shm_attach(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    if (id >= MAX_SHM_SEGMENTS)
     {
+        return 0;
+    }
 
-        while (rtc_get_seconds() < target_seconds)
-        {
-            _hlt();
-        }
+    return (uint64_t)shm_attach(get_current_process(), (uint16_t)id);
+}
+
+uint64_t sys_shm_detach(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    if (id >= MAX_SHM_SEGMENTS)
+    {
+        return (uint64_t)-1;
     }
-    else
+
+    int8_t result = shm_detach(get_current_process(), (uint16_t)id);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_shm_destroy(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    if (id >= MAX_SHM_SEGMENTS)
     {
+        return (uint64_t)-1;
+    }
 
-        while (rtc_get_seconds() >= start_seconds || rtc_get_seconds() < target_seconds)
-        {
-            _hlt();
-        }
+    int8_t result = shm_destroy((uint16_t)id);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_mq_create(uint64_t id, uint64_t max_messages, uint64_t message_size, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3)
+{
+    if (id >= MAX_MESSAGE_QUEUES || max_messages > MQ_MAX_MESSAGES || message_size > MQ_MAX_MESSAGE_SIZE)
+    {
+        return (uint64_t)-1;
     }
 
-    return 0;
+    int8_t result = mq_create((uint16_t)id, (uint16_t)max_messages, (uint32_t)message_size);
+    return (uint64_t)(int64_t)result;
 }
 
-uint64_t sys_get_ticks(uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5, uint64_t _unused6)
+uint64_t sys_mq_destroy(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    if (id >= MAX_MESSAGE_QUEUES)
+    {
+        return (uint64_t)-1;
+    }
+
+    int8_t result = mq_destroy((uint16_t)id);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_mq_send(uint64_t id, uint64_t message, uint64_t length, uint64_t priority, uint64_t _unused1, uint64_t _unused2)
+{
+    if (id >= MAX_MESSAGE_QUEUES || length > MQ_MAX_MESSAGE_SIZE || priority >= MQ_PRIORITIES)
+    {
+        return (uint64_t)-1;
+    }
+
+    int8_t result = mq_send((uint16_t)id, (const char *)message, (uint32_t)length, (uint8_t)priority);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_mq_receive(uint64_t id, uint64_t buffer, uint64_t length, uint64_t priority_ptr, uint64_t _unused1, uint64_t _unused2)
+{
+    if (id >= MAX_MESSAGE_QUEUES)
+    {
+        return (uint64_t)-1;
+    }
+
+    if (length > MQ_MAX_MESSAGE_SIZE)
+    {
+        length = MQ_MAX_MESSAGE_SIZE;
+    }
+
+    int64_t result = mq_receive((uint16_t)id, (char *)buffer, (uint32_t)length, (uint8_t *)priority_ptr);
+    return (uint64_t)result;
+}
+
+uint64_t sys_futex_wait(uint64_t address, uint64_t expected, uint64_t timeout_ticks, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3)
+{
+    int8_t result = futex_wait((int32_t *)address, (int32_t)expected, timeout_ticks);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_futex_wake(uint64_t address, uint64_t count, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4)
+{
+    if (count > INT32_MAX)
+    {
+        count = INT32_MAX;
+    }
+
+    int32_t result = futex_wake((int32_t *)address, (uint32_t)count);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_rwlock_create(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    if (id >= MAX_RWLOCKS)
+        return (uint64_t)-1;
+
+    int8_t result = rwlock_create((uint16_t)id);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_rwlock_destroy(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
 {
-    return (uint64_t)ticks_elapsed();
-}
\ No newline at end of file
+    if (id >= MAX_RWLOCKS)
+        return (uint64_t)-1;
+
+    int8_t result = rwlock_destroy((uint16_t)id);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_rwlock_lock(uint64_t id, uint64_t mode, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4)
+{
+    if (id >= MAX_RWLOCKS || mode > RWLOCK_WRITE)
+        return (uint64_t)-1;
+
+    int8_t result = rwlock_lock((uint16_t)id, (uint8_t)mode);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_rwlock_unlock(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    if (id >= MAX_RWLOCKS)
+        return (uint64_t)-1;
+
+    int8_t result = rwlock_unlock((uint16_t)id);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_cond_create(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    if (id >= MAX_CONDVARS)
+        return (uint64_t)-1;
+
+    int8_t result = cond_create((uint16_t)id);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_cond_destroy(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    if (id >= MAX_CONDVARS)
+        return (uint64_t)-1;
+
+    int8_t result = cond_destroy((uint16_t)id);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_cond_wait(uint64_t id, uint64_t sem_id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4)
+{
+    if (id >= MAX_CONDVARS || sem_id >= MAX_SEMAPHORES)
+        return (uint64_t)-1;
+
+    int8_t result = cond_wait((uint16_t)id, (uint16_t)sem_id);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_cond_signal(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    if (id >= MAX_CONDVARS)
+        return (uint64_t)-1;
+
+    int8_t result = cond_signal((uint16_t)id);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_cond_broadcast(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    if (id >= MAX_CONDVARS)
+        return (uint64_t)-1;
+
+    int8_t result = cond_broadcast((uint16_t)id);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_barrier_create(uint64_t id, uint64_t parties, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4)
+{
+    if (id >= MAX_BARRIERS || parties > UINT32_MAX)
+        return (uint64_t)-1;
+
+    int8_t result = barrier_create((uint16_t)id, (uint32_t)parties);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_barrier_destroy(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    if (id >= MAX_BARRIERS)
+        return (uint64_t)-1;
+
+    int8_t result = barrier_destroy((uint16_t)id);
+    return (uint64_t)(int64_t)result;
+}
+
+uint64_t sys_barrier_wait(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5)
+{
+    if (id >= MAX_BARRIERS)
+        return (uint64_t)-1;
+
+    int8_t result = barrier_wait((uint16_t)id);
+    return (uint64_t)(int64_t)result;
+}
+
+static int16_t resolve_fd(uint64_t fd)
+{
+    return (fd < 3) ? get_process_fd((uint8_t)fd) : (int16_t)fd;
+}
+
+static void stdout_sink(const char *data, uint64_t len)
+{
+    console_write(data, len, 0xFFFFFF);
+}
+
+static void stderr_sink(const char *data, uint64_t len)
+{
+    console_write(data, len, 0xFF0000);
+}
+
+// Moves (or, for tee, copies) pipe data to another pipe or a console sink without a user buffer.
+static int64_t transfer(uint64_t fd_in, uint64_t fd_out, uint64_t len, uint8_t consume)
+{
+    int16_t in = resolve_fd(fd_in);
+    int16_t out = resolve_fd(fd_out);
+
+    if (in < BUILT_IN_DESCRIPTORS)
+    {
+        return -1;
+    }
+
+    if (out >= BUILT_IN_DESCRIPTORS)
+    {
+        return pipe_splice((uint16_t)in, (uint16_t)out, len, consume);
+    }
+
+    switch (out)
+    {
+    case STDOUT:
+        return pipe_drain((uint16_t)in, stdout_sink, len, consume);
+    case STDERR:
+        return pipe_drain((uint16_t)in, stderr_sink, len, consume);
+    case DEV_NULL:
+        return pipe_drain((uint16_t)in, NULL, len, consume);
+    default:
+        return -1;
+    }
+}
@@ -4,20 +4,167 @@
 
 #include <time.h>
 #include <stdint.h>
+#include <hpet.h>
+#include <lib.h>
+#include <timer.h>
+#include <apic.h>
+#include <smp.h>
+#include <kernelInfo.h>
 
-static unsigned long ticks = 0;
+#define PIT_FREQUENCY 1193182
+#define PIT_MAX_COUNT 0xFFFF
+#define PIT_CHANNEL0_DATA 0x40
+#define PIT_COMMAND 0x43
+#define PIT_CHANNEL0_SQUARE_WAVE 0x36
+#define PIT_CHANNEL0_ONE_SHOT 0x30
+#define PIT_CHANNEL0_LATCH 0x00
+#define PIT_CHANNEL0_READ_STATUS 0xE2
+#define PIT_STATUS_OUTPUT 0x80
+
+static volatile uint64_t ticks = 0;
+static uint64_t hpet_boot_ns = 0;
+
+static uint16_t pit_divisor;
+// Ticks covered by the pending one-shot PIT interrupt, 0 while periodic.
+static uint32_t stretched_ticks = 0;
+static uint8_t lapic_stopped[MAX_CPUS];
+
+static void pit_program(uint8_t mode, uint16_t count)
+{
+	outb(PIT_COMMAND, mode);
+	outb(PIT_CHANNEL0_DATA, count & 0xFF);
+	outb(PIT_CHANNEL0_DATA, count >> 8);
+}
+
+static void pit_resume_periodic(void)
+{
+	if (!stretched_ticks)
+		return;
+
+	uint32_t elapsed;
+
+	outb(PIT_COMMAND, PIT_CHANNEL0_READ_STATUS);
+	if (inb(PIT_CHANNEL0_DATA) & PIT_STATUS_OUTPUT)
+	{
+		elapsed = stretched_ticks - 1;
+	}
+	else
+	{
+		outb(PIT_COMMAND, PIT_CHANNEL0_LATCH);
+		uint16_t remaining = inb(PIT_CHANNEL0_DATA);
+		remaining |= (uint16_t)inb(PIT_CHANNEL0_DATA) << 8;
+		elapsed = (stretched_ticks * pit_divisor - remaining) / pit_divisor;
+	}
+
+	// Either way one IRQ0 is still due (the expiry itself, or the edge of
+	// switching back to mode 3), and it accounts for the tick in progress.
+	ticks += elapsed;
+	kernel_info_tick(ticks);
+	stretched_ticks = 0;
+	pit_program(PIT_CHANNEL0_SQUARE_WAVE, pit_divisor);
+}
+
+void timer_init()
+{
+	pit_divisor = (PIT_FREQUENCY + TICK_HZ / 2) / TICK_HZ;
+	pit_program(PIT_CHANNEL0_SQUARE_WAVE, pit_divisor);
+
+	timer_queue_init();
+
+	hpet_init();
+	hpet_boot_ns = hpet_nanoseconds();
+}
 
 void timer_handler()
 {
-	ticks++;
+	if (stretched_ticks)
+	{
+		ticks += stretched_ticks;
+		stretched_ticks = 0;
+		pit_program(PIT_CHANNEL0_SQUARE_WAVE, pit_divisor);
+	}
+	else
+	{
+		ticks++;
+	}
+
+	kernel_info_tick(ticks);
+
+	timer_expire(ticks);
 }
 
-int ticks_elapsed()
+void tick_stop()
+{
+	uint8_t cpu = smp_cpu_index();
+
+	if (cpu != 0)
+	{
+		if (!lapic_stopped[cpu])
+		{
+			lapic_stop_timer();
+			lapic_stopped[cpu] = 1;
+		}
+		return;
+	}
+
+	if (stretched_ticks)
+		return;
+
+	uint64_t span = PIT_MAX_COUNT / pit_divisor;
+	uint64_t next = timer_next_deadline();
+
+	if (next != UINT64_MAX && next - ticks < span)
+		span = next > ticks ? next - ticks : 0;
+
+	if (span <= 1)
+		return;
+
+	stretched_ticks = (uint32_t)span;
+	pit_program(PIT_CHANNEL0_ONE_SHOT, (uint16_t)(span * pit_divisor));
+}
+
+void tick_resume()
+{
+	uint8_t cpu = smp_cpu_index();
+
+	if (cpu != 0)
+	{
+		if (lapic_stopped[cpu])
+		{
+			lapic_start_timer(TICK_HZ);
+			lapic_stopped[cpu] = 0;
+		}
+		return;
+	}
+
+	pit_resume_periodic();
+}
+
+void tick_deadline_armed(uint64_t deadline)
+{
+	if (stretched_ticks && deadline < ticks + stretched_ticks)
+		pit_resume_periodic();
+}
+
+uint64_t ticks_elapsed()
 {
 	return ticks;
 }
 
-int seconds_elapsed()
+uint64_t seconds_elapsed()
+{
+	return ticks / TICK_HZ;
+}
+
+uint64_t boot_hpet_nanoseconds()
 {
-	return ticks / 18;
-}
\ No newline at end of file
+	return hpet_boot_ns;
+}
+
+uint64_t nanoseconds_since_boot()
+{
+	if (hpet_is_present())
+		return hpet_nanoseconds() - hpet_boot_ns;
+
+	return ticks * NS_PER_TICK;
+}
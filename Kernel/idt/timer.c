@@ -0,0 +1,74 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+
+#include <stddef.h>
+#include <timer.h>
+#include <time.h>
+#include <list.h>
+
+// Pending timers sorted by deadline (in ticks), earliest first.
+static List timer_queue;
+
+void timer_queue_init(void)
+{
+    list_init(&timer_queue);
+}
+
+void timer_init_entry(Timer *timer)
+{
+    list_node_init(&timer->node);
+    timer->deadline = 0;
+    timer->callback = NULL;
+    timer->data = NULL;
+}
+
+void timer_arm(Timer *timer, uint64_t deadline, TimerCallback callback, void *data)
+{
+    timer_cancel(timer);
+
+    timer->deadline = deadline;
+    timer->callback = callback;
+    timer->data = data;
+
+    ListNode *node = list_get_first(&timer_queue);
+    while (node != NULL && list_entry(node, Timer, node)->deadline <= deadline)
+    {
+        node = list_next(&timer_queue, node);
+    }
+
+    list_insert_before(&timer_queue, node, &timer->node);
+    tick_deadline_armed(deadline);
+}
+
+void timer_cancel(Timer *timer)
+{
+    list_remove(&timer_queue, &timer->node);
+}
+
+void timer_expire(uint64_t now)
+{
+    ListNode *node;
+
+    while ((node = list_get_first(&timer_queue)) != NULL)
+    {
+        Timer *timer = list_entry(node, Timer, node);
+
+        if (timer->deadline > now)
+            break;
+
+        list_remove(&timer_queue, node);
+        timer->callback(timer->data);
+    }
+}
+
+uint64_t timer_next_deadline(void)
+{
+    ListNode *node = list_get_first(&timer_queue);
+    return node == NULL ? UINT64_MAX : list_entry(node, Timer, node)->deadline;
+}
+
+uint64_t ns_to_ticks(uint64_t ns)
+{
+    return (ns + NS_PER_TICK - 1) / NS_PER_TICK;
+}
@@ -0,0 +1,20 @@
+#ifndef APIC_H
+#define APIC_H
+
+#include <stdint.h>
+
+#define LAPIC_TIMER_VECTOR 0x40
+#define RESCHEDULE_VECTOR 0x41
+#define AP_START_VECTOR 0x42
+
+void lapic_init(void);
+uint8_t lapic_is_present(void);
+uint64_t lapic_get_address(void);
+uint8_t lapic_get_id(void);
+void lapic_eoi(void);
+void lapic_send_ipi(uint8_t apic_id, uint8_t vector);
+void lapic_calibrate_timer(void);
+void lapic_start_timer(uint32_t hz);
+void lapic_stop_timer(void);
+
+#endif
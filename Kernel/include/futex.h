@@ -0,0 +1,14 @@
+#ifndef FUTEX_H
+#define FUTEX_H
+
+#include <stdint.h>
+
+#define FUTEX_BUCKETS 64
+#define FUTEX_NO_TIMEOUT ((uint64_t)-1)
+#define FUTEX_TIMED_OUT -2
+
+void futex_init(void);
+int8_t futex_wait(int32_t *address, int32_t expected, uint64_t timeout_ticks);
+int32_t futex_wake(int32_t *address, uint32_t count);
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef HPET_H
+#define HPET_H
+
+#include <stdint.h>
+
+void hpet_init(void);
+uint8_t hpet_is_present(void);
+uint64_t hpet_nanoseconds(void);
+uint64_t hpet_get_address(void);
+uint64_t hpet_get_period_fs(void);
+
+#endif
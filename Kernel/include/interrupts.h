@@ -11,6 +11,13 @@ void _irq01Handler(void);
 void _int80Handler(void);
 void _yieldHandler(void);
 
+void _syscallHandler(void);
+void _syscallInit(void);
+
+void _apicTimerHandler(void);
+void _rescheduleHandler(void);
+void _apStartHandler(void);
+
 void _exception0Handler(void);
 void _exception6Handler(void);
 
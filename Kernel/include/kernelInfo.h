@@ -0,0 +1,37 @@
+#ifndef KERNEL_INFO_H
+#define KERNEL_INFO_H
+
+#include <stdint.h>
+#include "smp.h"
+
+#define KERNEL_INFO_ADDRESS 0x90000
+#define KERNEL_INFO_VERSION 1
+
+typedef struct
+{
+    volatile uint64_t switch_count;
+    volatile uint16_t pid;
+} KernelInfoCpu;
+
+// Published at KERNEL_INFO_ADDRESS; userland only reads it.
+typedef struct
+{
+    uint32_t version;
+    uint32_t tick_hz;
+    volatile uint64_t ticks;
+    uint64_t hpet_address;
+    uint64_t hpet_period_fs;
+    uint64_t hpet_boot_ns;
+    uint64_t lapic_address;
+    uint8_t cpu_count;
+    uint8_t apic_to_cpu[256];
+    KernelInfoCpu cpus[MAX_CPUS];
+    volatile uint64_t memory_total;
+    volatile uint64_t memory_free;
+} KernelInfoPage;
+
+void kernel_info_init(void);
+void kernel_info_tick(uint64_t ticks);
+void kernel_info_switch(uint8_t cpu, uint16_t pid);
+
+#endif
@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 
+#define KEYBOARD_EOF ((char)-1)
+
 void keyboard_handler();
 
 void init_keyboard(void);
@@ -11,4 +13,7 @@ char getChar(void);
 
 char getCharBlocking(void);
 
+struct PollWaiter;
+uint8_t keyboard_poll(uint8_t events, struct PollWaiter *waiter);
+
 #endif
\ No newline at end of file
@@ -12,6 +12,8 @@ char *strcpy(char *dest, const char *src);
 uint8_t inb(uint16_t port);
 void outb(uint16_t port, uint8_t value);
 int _xchg(int *ptr, int value);
+int _cmpxchg(int *ptr, int expected, int desired);
+int _xadd(int *ptr, int value);
 
 extern uintptr_t __stack_chk_guard;
 void __attribute__((noreturn)) __stack_chk_fail(void);
@@ -1,30 +1,31 @@
 #ifndef LIST_H
 #define LIST_H
 
-typedef struct Node
+#include <stddef.h>
+
+typedef struct ListNode
 {
-    void *data;
-    struct Node *prev;
-    struct Node *next;
-} Node;
+    struct ListNode *prev;
+    struct ListNode *next;
+} ListNode;
 
 typedef struct List
 {
-    Node *head;
-    Node *tail;
-    Node *iterator;
+    ListNode sentinel;
     int size;
 } List;
 
+#define list_entry(node, type, member) ((type *)((char *)(node) - offsetof(type, member)))
+
 void list_init(List *list);
-Node *list_append(List *list, void *data);
-Node *list_prepend(List *list, void *data);
-void *list_remove(List *list, Node *node);
-Node *list_get_first(List *list);
+void list_node_init(ListNode *node);
+int list_node_is_linked(ListNode *node);
+void list_append(List *list, ListNode *node);
+void list_prepend(List *list, ListNode *node);
+void list_insert_before(List *list, ListNode *position, ListNode *node);
+void list_remove(List *list, ListNode *node);
+ListNode *list_get_first(List *list);
+ListNode *list_next(List *list, ListNode *node);
 int list_is_empty(List *list);
 
-void list_begin(List *list);
-int list_has_next(List *list);
-void *list_next(List *list);
-
 #endif
@@ -0,0 +1,17 @@
+#ifndef MESSAGE_QUEUE_H
+#define MESSAGE_QUEUE_H
+
+#include <stdint.h>
+
+#define MAX_MESSAGE_QUEUES 64
+#define MQ_PRIORITIES 8
+#define MQ_MAX_MESSAGES 256
+#define MQ_MAX_MESSAGE_SIZE 1024
+
+void message_queue_manager_init(void);
+int8_t mq_create(uint16_t id, uint16_t max_messages, uint32_t message_size);
+int8_t mq_destroy(uint16_t id);
+int8_t mq_send(uint16_t id, const char *message, uint32_t length, uint8_t priority);
+int64_t mq_receive(uint16_t id, char *buffer, uint32_t length, uint8_t *priority);
+
+#endif
@@ -2,21 +2,39 @@
 #define PIPE_H
 
 #include <stdint.h>
+#include "list.h"
 
-#define PIPE_SIZE 4096
+#define PIPE_MIN_CAPACITY 512
+#define PIPE_INITIAL_SIZE 4096
+#define PIPE_DEFAULT_CAPACITY 16384
+#define PIPE_MAX_CAPACITY 65536
+#define PIPE_GROW_THRESHOLD 4
 #define MAX_PIPES 4096
+#define O_NONBLOCK 0x01
+#define PIPE_WOULD_BLOCK -2
 #define PIPE_MANAGER_ADDRESS 0x80000
-#define EOF_MARKER -1
-#define bufferPosition(pipe) (((pipe)->startPosition + (pipe)->currentSize) % PIPE_SIZE)
+#define bufferPosition(pipe) (((pipe)->startPosition + (pipe)->currentSize) % (pipe)->size)
+#define readerGone(pipe) ((pipe)->readers == 0 && (pipe)->readerOpened)
+
+typedef void (*PipeSink)(const char *data, uint64_t len);
 
 typedef struct Pipe
 {
-    char buffer[PIPE_SIZE];
-    uint16_t startPosition;
-    uint16_t currentSize;
-    int16_t inputPid;
-    int16_t outputPid;
-    uint8_t isBlocking;
+    char *buffer;
+    uint32_t size;
+    uint32_t capacity;
+    uint32_t startPosition;
+    uint32_t currentSize;
+    uint16_t readers;
+    uint16_t writers;
+    List readQueue;
+    List writeQueue;
+    List pollQueue;
+    uint8_t flags;
+    uint8_t readerOpened;
+    uint8_t writerClosed;
+    uint8_t fullWaits;
+    uint32_t generation;
 } Pipe;
 
 typedef struct PipeManager
@@ -28,9 +46,16 @@ typedef struct PipeManager
 
 void pipe_manager_init();
 int16_t pipe_get();
-int8_t pipe_open(uint16_t pid, uint16_t id, uint8_t mode);
-int8_t pipe_close(uint16_t pid, uint16_t id);
+int16_t pipe_create(uint32_t capacity);
+int8_t pipe_open(uint16_t id, uint8_t mode);
+int8_t pipe_close(uint16_t id, uint8_t mode);
 int64_t pipe_read(uint16_t id, char *buffer, uint64_t len);
-int64_t pipe_write(uint16_t pid, uint16_t id, const char *buffer, uint64_t len);
+int64_t pipe_write(uint16_t id, const char *buffer, uint64_t len);
+int64_t pipe_splice(uint16_t inId, uint16_t outId, uint64_t len, uint8_t consume);
+int64_t pipe_drain(uint16_t id, PipeSink sink, uint64_t len, uint8_t consume);
+int8_t pipe_set_flags(uint16_t id, uint8_t flags);
+
+struct PollWaiter;
+uint8_t pipe_poll(uint16_t id, uint8_t events, struct PollWaiter *waiter);
 
 #endif
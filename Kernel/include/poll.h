@@ -0,0 +1,36 @@
+#ifndef POLL_H
+#define POLL_H
+
+#include <stdint.h>
+#include "list.h"
+#include "process.h"
+
+#define POLLIN 0x01
+#define POLLOUT 0x02
+#define POLLHUP 0x04
+#define POLLNVAL 0x08
+
+#define MAX_POLL_FDS 8
+#define POLL_NO_TIMEOUT ((uint64_t)-1)
+
+typedef struct
+{
+    int16_t fd;
+    uint8_t events;
+    uint8_t revents;
+} PollFd;
+
+typedef struct PollWaiter
+{
+    ListNode node;
+    List *queue;
+    Process *process;
+} PollWaiter;
+
+void poll_wait_on(PollWaiter *waiter, List *queue);
+void poll_notify(List *queue);
+void poll_detach_all(List *queue);
+void poll_release(Process *process);
+int32_t poll(PollFd *fds, uint32_t count, uint64_t timeout_ticks);
+
+#endif
@@ -4,19 +4,29 @@
 #include <stdint.h>
 #include "globals.h"
 #include "list.h"
+#include "timer.h"
 
 #define PROCESS_STACK_SIZE 4096
+#define PROCESS_NAME_LEN 64
+#define MAX_PROCESS_SHM 8
+#define MAX_PROCESS_RWLOCKS 8
 
 typedef struct
 {
     uint16_t pid;
     uint16_t parent_pid;
-    char name[64];
+    char name[PROCESS_NAME_LEN];
     uint8_t priority;
     ProcessStatus status;
     void *stack_base;
     void *stack_pos;
     uint8_t is_foreground;
+    uint8_t last_cpu;
+    uint64_t run_ticks;
+    uint64_t ready_ticks;
+    uint64_t blocked_ticks;
+    uint64_t voluntary_switches;
+    uint64_t involuntary_switches;
 } ProcessInfo;
 
 typedef struct Process
@@ -32,17 +42,50 @@ typedef struct Process
     int16_t file_descriptors[3];
     int32_t return_value;
     uint8_t unkillable;
+    uint8_t is_idle;
+    uint8_t cpu;
+    uint8_t release_pending;
 
     uint16_t quantum_consumed_count;
 
+    // CPU accounting: state_since is the tick the current status was entered.
+    uint8_t last_cpu;
+    uint64_t state_since;
+    uint64_t run_ticks;
+    uint64_t ready_ticks;
+    uint64_t blocked_ticks;
+    uint64_t voluntary_switches;
+    uint64_t involuntary_switches;
+
     uint16_t waiting_for_pid;
+    uint8_t block_reason;
     List zombie_children;
+
+    ListNode ready_node;
+    ListNode zombie_node;
+    ListNode wait_node;
+    List *wait_queue;
+    Timer sleep_timer;
+    struct PollWaiter *poll_waiters;
+    uint16_t poll_count;
+    int16_t shm_ids[MAX_PROCESS_SHM];
+    int16_t rwlock_ids[MAX_PROCESS_RWLOCKS];
+    uintptr_t futex_key;
+    uint8_t inherited_priority;
+    List owned_mutexes;
+    struct Semaphore *waiting_semaphore;
 } Process;
 
+void init_process_caches(void);
 int8_t init_process(Process *process, uint16_t pid, uint16_t parent_pid,
                     MainFunction code, char **args, char *name,
                     uint8_t priority, int16_t fds[3], uint8_t unkillable);
 void free_process(Process *process);
+void process_wait_on(Process *process, List *queue);
+void process_stop_waiting(Process *process);
+void process_block_on(List *queue, uint8_t reason);
+void process_wake_one(List *queue);
+void process_wake_all(List *queue);
 int16_t get_process_fd(uint8_t fd_index);
 int32_t get_process_info(ProcessInfo *info_array, uint32_t max_count);
 
@@ -4,8 +4,12 @@
 #include <stdint.h>
 #include "process.h"
 #include "globals.h"
+#include "smp.h"
+#include "trace.h"
 
-#define MAX_PROCESSES 20
+#define MAX_PIDS 4096
+#define PID_CHUNK_SIZE 64
+#define PID_CHUNKS (MAX_PIDS / PID_CHUNK_SIZE)
 #define IDLE_PID 0
 #define NUM_PRIORITIES 5
 #define AGING_THRESHOLD 10
@@ -13,14 +17,26 @@
 
 typedef struct
 {
-    Node *processes[MAX_PROCESSES];
-    List ready_queues[NUM_PRIORITIES];
-    List blocked_queue;
-    uint16_t current_pid;
-    uint16_t next_unused_pid;
-    uint16_t num_processes;
+    Process *current;
+    Process *idle;
     int16_t remaining_quantum;
     int16_t initial_quantum;
+    uint8_t started;
+    uint8_t yielded;
+} CpuScheduler;
+
+typedef struct
+{
+    // pid -> Process, in chunks allocated the first time one of their pids is handed out.
+    Process **pid_chunks[PID_CHUNKS];
+    // One bit per pid in use, and one summary bit per full bitmap word.
+    uint64_t pid_bitmap[PID_CHUNKS];
+    uint64_t full_pid_words;
+    List ready_queues[NUM_PRIORITIES];
+    uint32_t ready_bitmap;
+    CpuScheduler cpus[MAX_CPUS];
+    uint16_t next_pid;
+    uint16_t num_processes;
     uint8_t kill_fg_flag;
     uint16_t foreground_pid;
     uint8_t current_priority_level;
@@ -29,6 +45,7 @@ typedef struct
 void scheduler_init();
 int16_t create_process(MainFunction code, char **args, char *name,
                        uint8_t priority, int16_t fds[3], uint8_t unkillable);
+int16_t create_idle_process(MainFunction code, uint8_t cpu);
 int32_t kill_process(uint16_t pid, int32_t retval);
 int32_t kill_current_process(int32_t retval);
 void kill_foreground_process(void);
@@ -36,10 +53,16 @@ uint16_t get_pid();
 void yield();
 int8_t set_priority(uint16_t pid, uint8_t new_priority);
 int8_t set_status(uint16_t pid, ProcessStatus new_status);
+int8_t block_process(uint16_t pid, uint8_t reason);
+uint8_t get_effective_priority(Process *process);
+void set_inherited_priority(Process *process, uint8_t priority);
 void *schedule(void *current_rsp);
 int32_t waitpid(uint16_t pid);
+void sleep_current_process(uint64_t ticks);
 Process *get_current_process();
 Process *get_process_by_pid(uint16_t pid);
+int32_t get_next_used_pid(uint16_t from);
+uint16_t get_process_count(void);
 uint16_t get_foreground_process_pid();
 
 #endif
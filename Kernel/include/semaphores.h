@@ -4,18 +4,27 @@
 #include <stdint.h>
 
 #define MAX_SEMAPHORES 4096
+#define SEM_NO_TIMEOUT ((uint64_t)-1)
+#define SEM_TIMED_OUT -2
 
 typedef uint16_t sem_t;
 
 typedef struct SemaphoreManagerCDT *SemaphoreManagerADT;
 
+struct Process;
+
 void semaphore_manager_init();
 
 int8_t sem_init(sem_t *sem, uint32_t initialValue);
+int8_t sem_init_mutex(sem_t *sem);
+int8_t sem_set_block_reason(sem_t *sem, uint8_t reason);
 int8_t sem_open(sem_t *sem);
 int8_t sem_close(sem_t *sem);
 int8_t sem_destroy(sem_t *sem);
 int8_t sem_post(sem_t *sem);
 int8_t sem_wait(sem_t *sem);
+int8_t sem_trywait(sem_t *sem);
+int8_t sem_timedwait(sem_t *sem, uint64_t timeout_ticks);
+void sem_release_owned(struct Process *process);
 
 #endif
@@ -0,0 +1,17 @@
+#ifndef SHM_H
+#define SHM_H
+
+#include <stdint.h>
+#include "process.h"
+
+#define MAX_SHM_SEGMENTS 64
+#define MAX_SHM_SIZE (1 << 20)
+
+void shm_manager_init(void);
+int8_t shm_create(uint16_t id, uint32_t size);
+void *shm_attach(Process *process, uint16_t id);
+int8_t shm_detach(Process *process, uint16_t id);
+int8_t shm_destroy(uint16_t id);
+void shm_release(Process *process);
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stdint.h>
+#include "list.h"
+
+#define MAX_KMEM_CACHES 16
+#define KMEM_CACHE_NAME_LEN 32
+#define SLAB_SIZE 4096
+
+typedef void (*KmemConstructor)(void *object);
+
+typedef struct KmemCache
+{
+    char name[KMEM_CACHE_NAME_LEN];
+    uint32_t object_size;
+    uint32_t objects_per_slab;
+    uint32_t slab_size;
+    KmemConstructor ctor;
+    void *free_objects;
+    List slabs;
+    uint32_t objects_in_use;
+    uint32_t objects_total;
+} KmemCache;
+
+typedef struct
+{
+    char name[KMEM_CACHE_NAME_LEN];
+    uint32_t object_size;
+    uint32_t objects_in_use;
+    uint32_t objects_total;
+    uint32_t slabs;
+} KmemCacheInfo;
+
+KmemCache *kmem_cache_create(const char *name, uint32_t object_size, KmemConstructor ctor);
+void *kmem_cache_alloc(KmemCache *cache);
+void kmem_cache_free(KmemCache *cache, void *object);
+int32_t kmem_cache_get_info(KmemCacheInfo *info_array, uint32_t max_count);
+
+#endif
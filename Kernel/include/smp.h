@@ -0,0 +1,19 @@
+#ifndef SMP_H
+#define SMP_H
+
+#include <stdint.h>
+
+#define MAX_CPUS 8
+#define NO_CPU 0xFF
+
+void smp_init(void);
+void smp_start_aps(void);
+void smp_ap_start(void);
+uint8_t smp_cpu_count(void);
+uint8_t smp_cpu_index(void);
+uint8_t smp_cpu_of_apic(uint8_t apic_id);
+void smp_reschedule(uint8_t cpu);
+void kernel_lock(void);
+void kernel_unlock(void);
+
+#endif
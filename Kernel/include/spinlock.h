@@ -0,0 +1,13 @@
+#ifndef SPINLOCK_H
+#define SPINLOCK_H
+
+#include <stdint.h>
+
+typedef int spinlock_t;
+
+#define SPINLOCK_INIT 0
+
+void spinlock_acquire(spinlock_t *lock);
+void spinlock_release(spinlock_t *lock);
+
+#endif
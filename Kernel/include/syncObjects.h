@@ -0,0 +1,36 @@
+#ifndef SYNC_OBJECTS_H
+#define SYNC_OBJECTS_H
+
+#include <stdint.h>
+
+struct Process;
+
+#define MAX_RWLOCKS 64
+#define MAX_CONDVARS 64
+#define MAX_BARRIERS 64
+
+#define RWLOCK_READ 0
+#define RWLOCK_WRITE 1
+
+#define BARRIER_SERIAL 1
+
+void sync_objects_init(void);
+
+int8_t rwlock_create(uint16_t id);
+int8_t rwlock_destroy(uint16_t id);
+int8_t rwlock_lock(uint16_t id, uint8_t mode);
+int8_t rwlock_unlock(uint16_t id);
+
+int8_t cond_create(uint16_t id);
+int8_t cond_destroy(uint16_t id);
+int8_t cond_wait(uint16_t id, uint16_t sem_id);
+int8_t cond_signal(uint16_t id);
+int8_t cond_broadcast(uint16_t id);
+
+int8_t barrier_create(uint16_t id, uint32_t parties);
+int8_t barrier_destroy(uint16_t id);
+int8_t barrier_wait(uint16_t id);
+
+void sync_release(struct Process *process);
+
+#endif
@@ -30,6 +30,41 @@
 #define SYSCALL_SLEEP 23
 #define SYSCALL_UNBLOCK 24
 #define SYSCALL_GET_TICKS 25
+#define SYSCALL_GET_KMEM_INFO 26
+#define SYSCALL_GET_TIME_NS 27
+#define SYSCALL_SLEEP_MS 28
+#define SYSCALL_NANOSLEEP 29
+#define SYSCALL_PIPE_CREATE 30
+#define SYSCALL_POLL 31
+#define SYSCALL_SET_FD_FLAGS 32
+#define SYSCALL_SPLICE 33
+#define SYSCALL_TEE 34
+#define SYSCALL_SHM_CREATE 35
+#define SYSCALL_SHM_ATTACH 36
+#define SYSCALL_SHM_DETACH 37
+#define SYSCALL_MQ_CREATE 38
+#define SYSCALL_MQ_DESTROY 39
+#define SYSCALL_MQ_SEND 40
+#define SYSCALL_MQ_RECEIVE 41
+#define SYSCALL_FUTEX_WAIT 42
+#define SYSCALL_FUTEX_WAKE 43
+#define SYSCALL_SEM_TRYWAIT 44
+#define SYSCALL_SEM_TIMEDWAIT 45
+#define SYSCALL_SEM_INIT_MUTEX 46
+#define SYSCALL_RWLOCK_CREATE 47
+#define SYSCALL_RWLOCK_DESTROY 48
+#define SYSCALL_RWLOCK_LOCK 49
+#define SYSCALL_RWLOCK_UNLOCK 50
+#define SYSCALL_COND_CREATE 51
+#define SYSCALL_COND_DESTROY 52
+#define SYSCALL_COND_WAIT 53
+#define SYSCALL_COND_SIGNAL 54
+#define SYSCALL_COND_BROADCAST 55
+#define SYSCALL_BARRIER_CREATE 56
+#define SYSCALL_BARRIER_DESTROY 57
+#define SYSCALL_BARRIER_WAIT 58
+#define SYSCALL_TRACE_DRAIN 59
+#define SYSCALL_SHM_DESTROY 60
 
 uint64_t sys_read(uint64_t fd, uint64_t buf, uint64_t count, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3);
 uint64_t sys_write(uint64_t fd, uint64_t buf, uint64_t count, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3);
@@ -44,10 +79,13 @@ uint64_t sys_block(uint64_t pid, uint64_t _unused1, uint64_t _unused2, uint64_t
 uint64_t sys_unblock(uint64_t pid, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
 uint64_t sys_waitpid(uint64_t pid, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
 uint64_t sys_sleep(uint64_t seconds, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_sleep_ms(uint64_t milliseconds, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_nanosleep(uint64_t nanoseconds, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
 
 uint64_t sys_malloc(uint64_t size, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
 uint64_t sys_free(uint64_t ptr, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
 uint64_t sys_mem_state(uint64_t total_ptr, uint64_t free_ptr, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4);
+uint64_t sys_get_kmem_info(uint64_t info_array_ptr, uint64_t max_count, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4);
 
 uint64_t sys_sem_init(uint64_t sem_id, uint64_t initial_value, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4);
 uint64_t sys_sem_open(uint64_t sem_id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
@@ -55,13 +93,45 @@ uint64_t sys_sem_close(uint64_t sem_id, uint64_t _unused1, uint64_t _unused2, ui
 uint64_t sys_sem_destroy(uint64_t sem_id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
 uint64_t sys_sem_wait(uint64_t sem_id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
 uint64_t sys_sem_post(uint64_t sem_id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_sem_trywait(uint64_t sem_id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_sem_timedwait(uint64_t sem_id, uint64_t timeout_ticks, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4);
+uint64_t sys_sem_init_mutex(uint64_t sem_id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
 
 uint64_t sys_pipe_open(uint64_t id, uint64_t mode, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4);
-uint64_t sys_pipe_close(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_pipe_close(uint64_t id, uint64_t mode, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4);
 uint64_t sys_pipe_get(uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5, uint64_t _unused6);
+uint64_t sys_pipe_create(uint64_t capacity, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_poll(uint64_t fds_ptr, uint64_t count, uint64_t timeout_ticks, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3);
+uint64_t sys_set_fd_flags(uint64_t fd, uint64_t flags, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4);
+uint64_t sys_splice(uint64_t fd_in, uint64_t fd_out, uint64_t len, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3);
+uint64_t sys_tee(uint64_t fd_in, uint64_t fd_out, uint64_t len, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3);
+uint64_t sys_shm_create(uint64_t id, uint64_t size, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4);
+uint64_t sys_shm_attach(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_shm_detach(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_shm_destroy(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_mq_create(uint64_t id, uint64_t max_messages, uint64_t message_size, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3);
+uint64_t sys_mq_destroy(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_mq_send(uint64_t id, uint64_t message, uint64_t length, uint64_t priority, uint64_t _unused1, uint64_t _unused2);
+uint64_t sys_mq_receive(uint64_t id, uint64_t buffer, uint64_t length, uint64_t priority_ptr, uint64_t _unused1, uint64_t _unused2);
+uint64_t sys_futex_wait(uint64_t address, uint64_t expected, uint64_t timeout_ticks, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3);
+uint64_t sys_futex_wake(uint64_t address, uint64_t count, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4);
+uint64_t sys_rwlock_create(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_rwlock_destroy(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_rwlock_lock(uint64_t id, uint64_t mode, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4);
+uint64_t sys_rwlock_unlock(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_cond_create(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_cond_destroy(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_cond_wait(uint64_t id, uint64_t sem_id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4);
+uint64_t sys_cond_signal(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_cond_broadcast(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_barrier_create(uint64_t id, uint64_t parties, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4);
+uint64_t sys_barrier_destroy(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
+uint64_t sys_barrier_wait(uint64_t id, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5);
 
 uint64_t sys_get_process_info(uint64_t info_array_ptr, uint64_t max_count, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4);
+uint64_t sys_trace_drain(uint64_t buffer_ptr, uint64_t max_count, uint64_t dropped_ptr, uint64_t _unused1, uint64_t _unused2, uint64_t _unused3);
 
 uint64_t sys_get_ticks(uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5, uint64_t _unused6);
+uint64_t sys_get_time_ns(uint64_t _unused1, uint64_t _unused2, uint64_t _unused3, uint64_t _unused4, uint64_t _unused5, uint64_t _unused6);
 
 #endif
\ No newline at end of file
@@ -3,8 +3,25 @@
 
 #include <stdint.h>
 
+#ifndef TICK_HZ
+#define TICK_HZ 250
+#endif
+
+#if TICK_HZ != 100 && TICK_HZ != 250 && TICK_HZ != 1000
+#error "TICK_HZ must be 100, 250 or 1000"
+#endif
+
+#define NS_PER_SECOND 1000000000ULL
+#define NS_PER_TICK (NS_PER_SECOND / TICK_HZ)
+
+void timer_init();
 void timer_handler();
-int ticks_elapsed();
-int seconds_elapsed();
+void tick_stop();
+void tick_resume();
+void tick_deadline_armed(uint64_t deadline);
+uint64_t ticks_elapsed();
+uint64_t seconds_elapsed();
+uint64_t nanoseconds_since_boot();
+uint64_t boot_hpet_nanoseconds();
 
 #endif
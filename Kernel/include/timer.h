@@ -0,0 +1,25 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdint.h>
+#include "list.h"
+
+typedef void (*TimerCallback)(void *data);
+
+typedef struct Timer
+{
+    ListNode node;
+    uint64_t deadline;
+    TimerCallback callback;
+    void *data;
+} Timer;
+
+void timer_queue_init(void);
+void timer_init_entry(Timer *timer);
+void timer_arm(Timer *timer, uint64_t deadline, TimerCallback callback, void *data);
+void timer_cancel(Timer *timer);
+void timer_expire(uint64_t now);
+uint64_t timer_next_deadline(void);
+uint64_t ns_to_ticks(uint64_t ns);
+
+#endif
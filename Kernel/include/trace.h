@@ -0,0 +1,46 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+#define TRACE_CAPACITY 1024
+
+typedef enum
+{
+    TRACE_SWITCH_IN = 0,
+    TRACE_SWITCH_OUT,
+    TRACE_BLOCK,
+    TRACE_UNBLOCK,
+    TRACE_AGING,
+    TRACE_KILL
+} TraceEventType;
+
+typedef enum
+{
+    BLOCK_OTHER = 0,
+    BLOCK_PIPE,
+    BLOCK_SEMAPHORE,
+    BLOCK_WAITPID,
+    BLOCK_KEYBOARD,
+    BLOCK_SLEEP,
+    BLOCK_POLL,
+    BLOCK_FUTEX,
+    BLOCK_MESSAGE_QUEUE,
+    BLOCK_SYNC,
+    BLOCK_MANUAL
+} BlockReason;
+
+// arg is the new priority for switch-in and aging, 1 for a voluntary switch-out, and the reason for block/unblock.
+typedef struct
+{
+    uint64_t tick;
+    uint16_t pid;
+    uint8_t type;
+    uint8_t cpu;
+    uint8_t arg;
+} TraceEvent;
+
+void trace_record(uint8_t type, uint16_t pid, uint8_t arg);
+uint32_t trace_drain(TraceEvent *buffer, uint32_t max_count, uint32_t *dropped);
+
+#endif
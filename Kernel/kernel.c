@@ -13,9 +13,16 @@
 #include <memoryManager.h>
 #include <scheduler.h>
 #include <semaphores.h>
+#include <futex.h>
+#include <syncObjects.h>
 #include <pipe.h>
+#include <shm.h>
+#include <messageQueue.h>
 #include <globals.h>
 #include <keyboardDriver.h>
+#include <smp.h>
+#include <time.h>
+#include <kernelInfo.h>
 
 extern uint8_t text;
 extern uint8_t rodata;
@@ -35,7 +42,6 @@ extern void start_userland();
 typedef int (*EntryPoint)();
 
 extern int idle_process(int argc, char **argv);
-extern void _sti();
 
 void clearBSS(void *bssAddress, uint64_t bssSize)
 {
@@ -71,21 +77,35 @@ int main()
 	load_idt();
 	initializeMemoryManagers();
 
+	timer_init();
+	smp_init();
+	kernel_info_init();
+
 	scheduler_init();
 
 	semaphore_manager_init();
+	futex_init();
+	sync_objects_init();
 
 	init_keyboard();
 
 	pipe_manager_init();
 
-	int16_t default_fds[3] = {STDIN, STDOUT, STDERR};
-	create_process(idle_process, NULL, "idle", 0, default_fds, 1);
+	shm_manager_init();
+
+	message_queue_manager_init();
 
+	for (uint8_t cpu = 0; cpu < smp_cpu_count(); cpu++)
+	{
+		create_idle_process(idle_process, cpu);
+	}
+
+	int16_t default_fds[3] = {STDIN, STDOUT, STDERR};
 	EntryPoint entryPoint = (EntryPoint)SHELL_CODE_START;
 	create_process((MainFunction)entryPoint, NULL, "shell", 2, default_fds, 0);
 
-	_sti();
+	kernel_lock();
+	smp_start_aps();
 	yield();
 
 	return 0;
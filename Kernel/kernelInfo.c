@@ -0,0 +1,46 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+
+#include <stdint.h>
+#include <lib.h>
+#include <kernelInfo.h>
+#include <smp.h>
+#include <apic.h>
+#include <hpet.h>
+#include <time.h>
+#include <memoryManagerInterface.h>
+
+static KernelInfoPage *info = (KernelInfoPage *)KERNEL_INFO_ADDRESS;
+
+void kernel_info_init(void)
+{
+    memset(info, 0, sizeof(KernelInfoPage));
+
+    info->version = KERNEL_INFO_VERSION;
+    info->tick_hz = TICK_HZ;
+    info->hpet_address = hpet_get_address();
+    info->hpet_period_fs = hpet_get_period_fs();
+    info->hpet_boot_ns = boot_hpet_nanoseconds();
+    info->lapic_address = lapic_get_address();
+    info->cpu_count = smp_cpu_count();
+
+    for (int apic_id = 0; apic_id < 256; apic_id++)
+    {
+        info->apic_to_cpu[apic_id] = smp_cpu_of_apic((uint8_t)apic_id);
+    }
+
+    mm_get_stats((uint64_t *)&info->memory_total, (uint64_t *)&info->memory_free);
+}
+
+void kernel_info_tick(uint64_t ticks)
+{
+    info->ticks = ticks;
+    mm_get_stats((uint64_t *)&info->memory_total, (uint64_t *)&info->memory_free);
+}
+
+void kernel_info_switch(uint8_t cpu, uint16_t pid)
+{
+    info->cpus[cpu].switch_count++;
+    info->cpus[cpu].pid = pid;
+}
@@ -3,113 +3,90 @@
 
 
 #include "../include/list.h"
-#include "../include/memoryManager.h"
 #include <stddef.h>
 
 void list_init(List *list)
 {
-    list->head = NULL;
-    list->tail = NULL;
-    list->iterator = NULL;
+    list->sentinel.prev = &list->sentinel;
+    list->sentinel.next = &list->sentinel;
     list->size = 0;
 }
 
-Node *list_append(List *list, void *data)
+void list_node_init(ListNode *node)
 {
-    Node *node = (Node *)mm_alloc(sizeof(Node));
-    if (node == NULL)
-    {
-        return NULL;
-    }
-
-    node->data = data;
+    node->prev = NULL;
     node->next = NULL;
-    node->prev = list->tail;
+}
+
+int list_node_is_linked(ListNode *node)
+{
+    return node->next != NULL;
+}
 
-    if (list->tail)
-        list->tail->next = node;
-    list->tail = node;
+void list_append(List *list, ListNode *node)
+{
+    node->next = &list->sentinel;
+    node->prev = list->sentinel.prev;
 
-    if (!list->head)
-        list->head = node;
+    list->sentinel.prev->next = node;
+    list->sentinel.prev = node;
 
     list->size++;
-    return node;
 }
 
-Node *list_prepend(List *list, void *data)
+void list_prepend(List *list, ListNode *node)
 {
-    Node *node = (Node *)mm_alloc(sizeof(Node));
-    if (node == NULL)
-    {
-        return NULL;
-    }
-
-    node->data = data;
-    node->next = list->head;
-    node->prev = NULL;
-
-    if (list->head)
-        list->head->prev = node;
-    list->head = node;
+    node->next = list->sentinel.next;
+    node->prev = &list->sentinel;
 
-    if (!list->tail)
-        list->tail = node;
+    list->sentinel.next->prev = node;
+    list->sentinel.next = node;
 
     list->size++;
-    return node;
 }
 
-void *list_remove(List *list, Node *node)
+void list_insert_before(List *list, ListNode *position, ListNode *node)
 {
-    if (!node)
-        return NULL;
-
-    if (node->prev)
-        node->prev->next = node->next;
-    else
-        list->head = node->next;
-
-    if (node->next)
-        node->next->prev = node->prev;
-    else
-        list->tail = node->prev;
+    if (position == NULL)
+    {
+        list_append(list, node);
+        return;
+    }
 
-    list->size--;
+    node->next = position;
+    node->prev = position->prev;
 
-    void *data = node->data;
-    mm_free(node);
+    position->prev->next = node;
+    position->prev = node;
 
-    return data;
+    list->size++;
 }
 
-Node *list_get_first(List *list)
+void list_remove(List *list, ListNode *node)
 {
-    return list->head;
-}
+    if (!node || !list_node_is_linked(node))
+        return;
 
-int list_is_empty(List *list)
-{
-    return list->head == NULL;
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+
+    node->prev = NULL;
+    node->next = NULL;
+
+    list->size--;
 }
 
-void list_begin(List *list)
+ListNode *list_get_first(List *list)
 {
-    list->iterator = list->head;
+    return list_is_empty(list) ? NULL : list->sentinel.next;
 }
 
-int list_has_next(List *list)
+ListNode *list_next(List *list, ListNode *node)
 {
-    return list->iterator != NULL;
+    return node->next == &list->sentinel ? NULL : node->next;
 }
 
-void *list_next(List *list)
+int list_is_empty(List *list)
 {
-    if (!list->iterator)
-        return NULL;
-
-    void *data = list->iterator->data;
-    list->iterator = list->iterator->next;
-
-    return data;
+    return list->sentinel.next == &list->sentinel;
 }
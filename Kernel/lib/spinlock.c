@@ -0,0 +1,23 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+
+#include <spinlock.h>
+#include <lib.h>
+
+void spinlock_acquire(spinlock_t *lock)
+{
+    while (_xchg(lock, 1))
+    {
+        while (*(volatile spinlock_t *)lock)
+        {
+            __asm__ volatile("pause");
+        }
+    }
+}
+
+void spinlock_release(spinlock_t *lock)
+{
+    __asm__ volatile("" ::: "memory");
+    *(volatile spinlock_t *)lock = 0;
+}
@@ -0,0 +1,137 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <shm.h>
+#include <memoryManager.h>
+#include <slab.h>
+#include <lib.h>
+#include <stddef.h>
+
+typedef struct Segment
+{
+    void *base;
+    uint32_t size;
+    uint16_t attachments;
+} Segment;
+
+static Segment *segments[MAX_SHM_SEGMENTS];
+static KmemCache *segment_cache;
+
+static int8_t find_slot(Process *process, int16_t id);
+static void drop_attachment(uint16_t id);
+static void free_segment(uint16_t id);
+
+void shm_manager_init(void)
+{
+    segment_cache = kmem_cache_create("shm", sizeof(Segment), NULL);
+
+    for (int i = 0; i < MAX_SHM_SEGMENTS; i++)
+        segments[i] = NULL;
+}
+
+int8_t shm_create(uint16_t id, uint32_t size)
+{
+    if (id >= MAX_SHM_SEGMENTS || segments[id] != NULL || size == 0 || size > MAX_SHM_SIZE)
+        return -1;
+
+    Segment *segment = (Segment *)kmem_cache_alloc(segment_cache);
+    if (segment == NULL)
+        return -1;
+
+    segment->base = mm_alloc(size);
+    if (segment->base == NULL)
+    {
+        kmem_cache_free(segment_cache, segment);
+        return -1;
+    }
+
+    memset(segment->base, 0, size);
+    segment->size = size;
+    segment->attachments = 0;
+
+    segments[id] = segment;
+    return 0;
+}
+
+void *shm_attach(Process *process, uint16_t id)
+{
+    if (id >= MAX_SHM_SEGMENTS || segments[id] == NULL)
+        return NULL;
+
+    // All processes share one address space, so attaching only pins the segment.
+    if (find_slot(process, (int16_t)id) != -1)
+        return segments[id]->base;
+
+    int8_t slot = find_slot(process, -1);
+    if (slot == -1)
+        return NULL;
+
+    process->shm_ids[slot] = (int16_t)id;
+    segments[id]->attachments++;
+    return segments[id]->base;
+}
+
+// Only for a segment nobody holds; an attached one is already freed by its last detach.
+int8_t shm_destroy(uint16_t id)
+{
+    if (id >= MAX_SHM_SEGMENTS || segments[id] == NULL || segments[id]->attachments > 0)
+        return -1;
+
+    free_segment(id);
+    return 0;
+}
+
+int8_t shm_detach(Process *process, uint16_t id)
+{
+    if (id >= MAX_SHM_SEGMENTS)
+        return -1;
+
+    int8_t slot = find_slot(process, (int16_t)id);
+    if (slot == -1)
+        return -1;
+
+    process->shm_ids[slot] = -1;
+    drop_attachment(id);
+    return 0;
+}
+
+void shm_release(Process *process)
+{
+    for (int i = 0; i < MAX_PROCESS_SHM; i++)
+    {
+        if (process->shm_ids[i] != -1)
+        {
+            drop_attachment((uint16_t)process->shm_ids[i]);
+            process->shm_ids[i] = -1;
+        }
+    }
+}
+
+static int8_t find_slot(Process *process, int16_t id)
+{
+    for (int8_t i = 0; i < MAX_PROCESS_SHM; i++)
+    {
+        if (process->shm_ids[i] == id)
+            return i;
+    }
+    return -1;
+}
+
+// A segment lives until the last process that attached to it lets go.
+static void drop_attachment(uint16_t id)
+{
+    Segment *segment = segments[id];
+    if (segment == NULL || segment->attachments == 0)
+        return;
+
+    if (--segment->attachments == 0)
+        free_segment(id);
+}
+
+static void free_segment(uint16_t id)
+{
+    Segment *segment = segments[id];
+    mm_free(segment->base);
+    kmem_cache_free(segment_cache, segment);
+    segments[id] = NULL;
+}
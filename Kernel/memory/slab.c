@@ -0,0 +1,121 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <stdint.h>
+#include <stddef.h>
+#include <slab.h>
+#include <list.h>
+#include <memoryManager.h>
+
+#define OBJECT_ALIGN sizeof(void *)
+
+typedef struct Slab
+{
+    ListNode node;
+} Slab;
+
+static KmemCache caches[MAX_KMEM_CACHES];
+static uint32_t cache_count = 0;
+
+static int cache_grow(KmemCache *cache);
+
+KmemCache *kmem_cache_create(const char *name, uint32_t object_size, KmemConstructor ctor)
+{
+    if (cache_count >= MAX_KMEM_CACHES || object_size == 0)
+        return NULL;
+
+    KmemCache *cache = &caches[cache_count];
+
+    int i;
+    for (i = 0; i < KMEM_CACHE_NAME_LEN - 1 && name[i] != '\0'; i++)
+        cache->name[i] = name[i];
+    cache->name[i] = '\0';
+
+    if (object_size < sizeof(void *))
+        object_size = sizeof(void *);
+    cache->object_size = (object_size + OBJECT_ALIGN - 1) & ~(OBJECT_ALIGN - 1);
+
+    cache->objects_per_slab = (SLAB_SIZE - sizeof(Slab)) / cache->object_size;
+    if (cache->objects_per_slab == 0)
+        cache->objects_per_slab = 1;
+    cache->slab_size = sizeof(Slab) + cache->objects_per_slab * cache->object_size;
+
+    cache->ctor = ctor;
+    cache->free_objects = NULL;
+    list_init(&cache->slabs);
+    cache->objects_in_use = 0;
+    cache->objects_total = 0;
+
+    cache_count++;
+    return cache;
+}
+
+void *kmem_cache_alloc(KmemCache *cache)
+{
+    if (cache->free_objects == NULL && cache_grow(cache) != 0)
+        return NULL;
+
+    void *object = cache->free_objects;
+    cache->free_objects = *(void **)object;
+    cache->objects_in_use++;
+
+    if (cache->ctor)
+        cache->ctor(object);
+
+    return object;
+}
+
+void kmem_cache_free(KmemCache *cache, void *object)
+{
+    if (object == NULL)
+        return;
+
+    *(void **)object = cache->free_objects;
+    cache->free_objects = object;
+    cache->objects_in_use--;
+}
+
+int32_t kmem_cache_get_info(KmemCacheInfo *info_array, uint32_t max_count)
+{
+    // Without a buffer, report how many entries a full listing needs.
+    if (!info_array || max_count == 0)
+        return cache_count;
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < cache_count && count < max_count; i++, count++)
+    {
+        KmemCache *cache = &caches[i];
+        KmemCacheInfo *info = &info_array[count];
+
+        int j;
+        for (j = 0; j < KMEM_CACHE_NAME_LEN - 1 && cache->name[j] != '\0'; j++)
+            info->name[j] = cache->name[j];
+        info->name[j] = '\0';
+
+        info->object_size = cache->object_size;
+        info->objects_in_use = cache->objects_in_use;
+        info->objects_total = cache->objects_total;
+        info->slabs = cache->slabs.size;
+    }
+
+    return count;
+}
+
+static int cache_grow(KmemCache *cache)
+{
+    Slab *slab = (Slab *)mm_alloc(cache->slab_size);
+    if (slab == NULL)
+        return -1;
+
+    list_append(&cache->slabs, &slab->node);
+
+    uint8_t *object = (uint8_t *)(slab + 1);
+    for (uint32_t i = 0; i < cache->objects_per_slab; i++, object += cache->object_size)
+    {
+        *(void **)object = cache->free_objects;
+        cache->free_objects = object;
+    }
+
+    cache->objects_total += cache->objects_per_slab;
+    return 0;
+}
@@ -0,0 +1,191 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <messageQueue.h>
+#include <memoryManager.h>
+#include <scheduler.h>
+#include <process.h>
+#include <slab.h>
+#include <list.h>
+#include <lib.h>
+#include <stddef.h>
+
+typedef struct Message
+{
+    ListNode node;
+    uint32_t length;
+    uint8_t priority;
+    char data[];
+} Message;
+
+typedef struct MessageQueue
+{
+    char *pool;
+    uint32_t slot_size;
+    uint32_t message_size;
+    uint16_t max_messages;
+    uint16_t count;
+    List free_slots;
+    List messages[MQ_PRIORITIES];
+    uint32_t priority_bitmap;
+    List senders;
+    List receivers;
+    uint32_t generation;
+} MessageQueue;
+
+static MessageQueue *queues[MAX_MESSAGE_QUEUES];
+static KmemCache *queue_cache;
+static uint32_t lastGeneration;
+
+static MessageQueue *get_queue(uint16_t id);
+static int8_t queue_is_alive(MessageQueue *queue, uint16_t id, uint32_t generation);
+
+void message_queue_manager_init(void)
+{
+    queue_cache = kmem_cache_create("mqueue", sizeof(MessageQueue), NULL);
+
+    for (int i = 0; i < MAX_MESSAGE_QUEUES; i++)
+        queues[i] = NULL;
+}
+
+int8_t mq_create(uint16_t id, uint16_t max_messages, uint32_t message_size)
+{
+    if (id >= MAX_MESSAGE_QUEUES || queues[id] != NULL ||
+        max_messages == 0 || max_messages > MQ_MAX_MESSAGES ||
+        message_size == 0 || message_size > MQ_MAX_MESSAGE_SIZE)
+        return -1;
+
+    MessageQueue *queue = (MessageQueue *)kmem_cache_alloc(queue_cache);
+    if (queue == NULL)
+        return -1;
+
+    // Every slot is carved out of one allocation up front, so sending never allocates.
+    queue->slot_size = (sizeof(Message) + message_size + 7) & ~7u;
+    queue->pool = (char *)mm_alloc(queue->slot_size * max_messages);
+    if (queue->pool == NULL)
+    {
+        kmem_cache_free(queue_cache, queue);
+        return -1;
+    }
+
+    queue->message_size = message_size;
+    queue->max_messages = max_messages;
+    queue->count = 0;
+    queue->priority_bitmap = 0;
+    queue->generation = ++lastGeneration;
+    list_init(&queue->free_slots);
+    list_init(&queue->senders);
+    list_init(&queue->receivers);
+
+    for (int i = 0; i < MQ_PRIORITIES; i++)
+        list_init(&queue->messages[i]);
+
+    for (uint16_t i = 0; i < max_messages; i++)
+    {
+        Message *slot = (Message *)(queue->pool + (uint32_t)i * queue->slot_size);
+        list_append(&queue->free_slots, &slot->node);
+    }
+
+    queues[id] = queue;
+    return 0;
+}
+
+int8_t mq_destroy(uint16_t id)
+{
+    MessageQueue *queue = get_queue(id);
+    if (queue == NULL)
+        return -1;
+
+    queues[id] = NULL;
+    process_wake_all(&queue->senders);
+    process_wake_all(&queue->receivers);
+
+    mm_free(queue->pool);
+    kmem_cache_free(queue_cache, queue);
+    return 0;
+}
+
+int8_t mq_send(uint16_t id, const char *message, uint32_t length, uint8_t priority)
+{
+    MessageQueue *queue = get_queue(id);
+    if (queue == NULL || message == NULL || length > queue->message_size || priority >= MQ_PRIORITIES)
+        return -1;
+
+    uint32_t generation = queue->generation;
+    while (queue->count >= queue->max_messages)
+    {
+        process_block_on(&queue->senders, BLOCK_MESSAGE_QUEUE);
+
+        if (!queue_is_alive(queue, id, generation))
+            return -1;
+    }
+
+    Message *slot = list_entry(list_get_first(&queue->free_slots), Message, node);
+    list_remove(&queue->free_slots, &slot->node);
+
+    memcpy(slot->data, message, length);
+    slot->length = length;
+    slot->priority = priority;
+
+    list_append(&queue->messages[priority], &slot->node);
+    queue->priority_bitmap |= (1u << priority);
+    queue->count++;
+
+    process_wake_one(&queue->receivers);
+    return 0;
+}
+
+int64_t mq_receive(uint16_t id, char *buffer, uint32_t length, uint8_t *priority)
+{
+    MessageQueue *queue = get_queue(id);
+    if (queue == NULL || buffer == NULL)
+        return -1;
+
+    uint32_t generation = queue->generation;
+    while (queue->count == 0)
+    {
+        process_block_on(&queue->receivers, BLOCK_MESSAGE_QUEUE);
+
+        if (!queue_is_alive(queue, id, generation))
+            return -1;
+    }
+
+    int level = 31 - __builtin_clz(queue->priority_bitmap);
+    List *messages = &queue->messages[level];
+    Message *slot = list_entry(list_get_first(messages), Message, node);
+
+    // Records are never split: a buffer too small for the next message leaves it queued.
+    if (slot->length > length)
+        return -1;
+
+    list_remove(messages, &slot->node);
+    if (list_is_empty(messages))
+        queue->priority_bitmap &= ~(1u << level);
+    queue->count--;
+
+    memcpy(buffer, slot->data, slot->length);
+    if (priority != NULL)
+        *priority = slot->priority;
+
+    int64_t received = slot->length;
+    list_append(&queue->free_slots, &slot->node);
+
+    process_wake_one(&queue->senders);
+    if (queue->count > 0)
+        process_wake_one(&queue->receivers);
+
+    return received;
+}
+
+static MessageQueue *get_queue(uint16_t id)
+{
+    if (id >= MAX_MESSAGE_QUEUES)
+        return NULL;
+    return queues[id];
+}
+
+// A destroyed queue's slab slot can back a new queue under the same id, so the address alone proves nothing.
+static int8_t queue_is_alive(MessageQueue *queue, uint16_t id, uint32_t generation)
+{
+    return queue == get_queue(id) && queue->generation == generation;
+}
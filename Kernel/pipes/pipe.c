@@ -3,20 +3,36 @@
 
 #include <pipe.h>
 #include <scheduler.h>
+#include <process.h>
+#include <poll.h>
 #include <memoryManager.h>
 #include <lib.h>
+#include <slab.h>
 #include <globals.h>
 #include <stddef.h>
 
 static int16_t get_pipe_index_by_id(uint16_t id);
 static Pipe *get_pipe_by_id(uint16_t id);
-static Pipe *create_pipe(void);
+static int8_t pipe_is_alive(Pipe *pipe, uint16_t id, uint32_t generation);
+static Pipe *create_pipe(uint32_t capacity);
 static void free_pipe(Pipe *pipe);
+static int8_t alloc_pipe_buffer(Pipe *pipe);
+static int8_t grow_pipe(Pipe *pipe);
+static int64_t wait_for_data(Pipe *pipe, uint16_t id);
+static int64_t wait_for_space(Pipe *pipe, uint16_t id);
+static uint32_t contiguous_data(Pipe *pipe, uint32_t len);
+static void produce_data(Pipe *pipe, const char *data, uint32_t len);
+static void consume_data(Pipe *pipe, uint32_t len);
+static void pipe_ctor(void *object);
 
 static PipeManager *pipeManager;
+static KmemCache *pipe_cache;
+static uint32_t lastGeneration;
 
 void pipe_manager_init()
 {
+    pipe_cache = kmem_cache_create("pipe", sizeof(Pipe), pipe_ctor);
+
     pipeManager = (PipeManager *)PIPE_MANAGER_ADDRESS;
     pipeManager->lastFreePipe = 0;
     pipeManager->qtyPipes = 0;
@@ -28,6 +44,11 @@ void pipe_manager_init()
 }
 
 int16_t pipe_get()
+{
+    return pipe_create(PIPE_DEFAULT_CAPACITY);
+}
+
+int16_t pipe_create(uint32_t capacity)
 {
     if (pipeManager->qtyPipes >= MAX_PIPES)
     {
@@ -39,7 +60,7 @@ int16_t pipe_get()
         pipeManager->lastFreePipe = (pipeManager->lastFreePipe + 1) % MAX_PIPES;
     }
 
-    Pipe *newPipe = create_pipe();
+    Pipe *newPipe = create_pipe(capacity);
     if (newPipe == NULL)
     {
         return -1;
@@ -54,10 +75,10 @@ int16_t pipe_get()
     return pipeId;
 }
 
-int8_t pipe_open(uint16_t pid, uint16_t id, uint8_t mode)
+int8_t pipe_open(uint16_t id, uint8_t mode)
 {
     int16_t index = get_pipe_index_by_id(id);
-    if (index == -1)
+    if (index == -1 || (mode != READ && mode != WRITE))
     {
         return -1;
     }
@@ -71,7 +92,7 @@ int8_t pipe_open(uint16_t pid, uint16_t id, uint8_t mode)
             return -1;
         }
 
-        pipe = create_pipe();
+        pipe = create_pipe(PIPE_DEFAULT_CAPACITY);
         if (pipe == NULL)
         {
             return -1;
@@ -83,41 +104,19 @@ int8_t pipe_open(uint16_t pid, uint16_t id, uint8_t mode)
 
     if (mode == WRITE)
     {
-        if (pipe->inputPid != -1 && pipe->inputPid != (int16_t)pid)
-        {
-            return -1;
-        }
-        pipe->inputPid = (int16_t)pid;
-
-        if (pipe->outputPid != -1 && pipe->isBlocking)
-        {
-            set_status(pipe->outputPid, READY);
-            pipe->isBlocking = 0;
-        }
-    }
-    else if (mode == READ)
-    {
-        if (pipe->outputPid != -1 && pipe->outputPid != (int16_t)pid)
-        {
-            return -1;
-        }
-        pipe->outputPid = (int16_t)pid;
-
-        if (pipe->inputPid != -1 && pipe->isBlocking)
-        {
-            set_status(pipe->inputPid, READY);
-            pipe->isBlocking = 0;
-        }
+        pipe->writers++;
+        pipe->writerClosed = 0;
     }
     else
     {
-        return -1;
+        pipe->readers++;
+        pipe->readerOpened = 1;
     }
 
     return 0;
 }
 
-int8_t pipe_close(uint16_t pid, uint16_t id)
+int8_t pipe_close(uint16_t id, uint8_t mode)
 {
     int16_t index = get_pipe_index_by_id(id);
     if (index == -1)
@@ -131,145 +130,341 @@ int8_t pipe_close(uint16_t pid, uint16_t id)
         return -1;
     }
 
-    if (pid == pipe->inputPid)
+    if (mode == WRITE && pipe->writers > 0)
     {
-        char eofString[1] = {EOF_MARKER};
-        pipe_write(pid, id, eofString, 1);
-        pipe->inputPid = -1;
-
-        if (pipe->isBlocking && pipe->outputPid != -1)
+        if (--pipe->writers == 0)
         {
-            set_status(pipe->outputPid, READY);
-            pipe->isBlocking = 0;
+            pipe->writerClosed = 1;
+            process_wake_all(&pipe->readQueue);
+            poll_notify(&pipe->pollQueue);
         }
     }
-
-    else if (pid == pipe->outputPid)
+    else if (mode == READ && pipe->readers > 0)
     {
-        pipe->outputPid = -1;
-
-        if (pipe->isBlocking && pipe->inputPid != -1)
+        if (--pipe->readers == 0)
         {
-            set_status(pipe->inputPid, READY);
-            pipe->isBlocking = 0;
+            process_wake_all(&pipe->writeQueue);
+            poll_notify(&pipe->pollQueue);
         }
-
-        free_pipe(pipe);
-        pipeManager->pipes[index] = NULL;
-        pipeManager->qtyPipes--;
     }
     else
     {
         return -1;
     }
 
+    // A pipe nobody has read from yet keeps its data for a late reader.
+    if (pipe->readers == 0 && pipe->writers == 0 && pipe->readerOpened)
+    {
+        free_pipe(pipe);
+        pipeManager->pipes[index] = NULL;
+        pipeManager->qtyPipes--;
+    }
+
     return 0;
 }
 
 int64_t pipe_read(uint16_t id, char *buffer, uint64_t len)
 {
     Pipe *pipe = get_pipe_by_id(id);
-    if (pipe == NULL || pipe->outputPid != (int16_t)get_pid() || len == 0)
+    if (pipe == NULL || pipe->readers == 0 || len == 0)
     {
         return -1;
     }
 
-    uint64_t readBytes = 0;
-    uint8_t eofRead = 0;
+    int64_t available = wait_for_data(pipe, id);
+    if (available <= 0)
+    {
+        return available;
+    }
+
+    uint32_t readBytes = len < (uint64_t)available ? (uint32_t)len : (uint32_t)available;
+    uint32_t firstSpan = contiguous_data(pipe, readBytes);
 
-    while (pipe->inputPid == -1 &&
-           pipe->currentSize == 0 &&
-           (int)pipe->buffer[pipe->startPosition] != EOF_MARKER)
+    memcpy(buffer, pipe->buffer + pipe->startPosition, firstSpan);
+    memcpy(buffer + firstSpan, pipe->buffer, readBytes - firstSpan);
+
+    consume_data(pipe, readBytes);
+    return readBytes;
+}
+
+int64_t pipe_write(uint16_t id, const char *buffer, uint64_t len)
+{
+    Pipe *pipe = get_pipe_by_id(id);
+    if (pipe == NULL || pipe->writers == 0 || len == 0)
     {
-        pipe->isBlocking = 1;
-        set_status(get_pid(), BLOCKED);
-        yield();
+        return -1;
+    }
+
+    uint64_t writtenBytes = 0;
 
-        if (pipe != get_pipe_by_id(id))
+    while (writtenBytes < len)
+    {
+        int64_t space = wait_for_space(pipe, id);
+        if (space < 0)
         {
-            return -1;
+            return writtenBytes > 0 ? (int64_t)writtenBytes : space;
         }
+
+        uint32_t chunk = len - writtenBytes < (uint64_t)space ? (uint32_t)(len - writtenBytes) : (uint32_t)space;
+        produce_data(pipe, buffer + writtenBytes, chunk);
+        writtenBytes += chunk;
     }
 
-    while (readBytes < len && !eofRead)
+    if (pipe->currentSize < pipe->size)
     {
+        process_wake_one(&pipe->writeQueue);
+    }
 
-        if (pipe->currentSize == 0 && (int)pipe->buffer[pipe->startPosition] != EOF_MARKER)
+    return writtenBytes;
+}
+
+int64_t pipe_splice(uint16_t inId, uint16_t outId, uint64_t len, uint8_t consume)
+{
+    Pipe *in = get_pipe_by_id(inId);
+    Pipe *out = get_pipe_by_id(outId);
+    if (in == NULL || out == NULL || in == out || in->readers == 0 || out->writers == 0 || len == 0)
+    {
+        return -1;
+    }
+
+    uint32_t inGeneration = in->generation;
+    uint32_t outGeneration = out->generation;
+
+    while (1)
+    {
+        int64_t available = wait_for_data(in, inId);
+        if (available <= 0)
         {
-            pipe->isBlocking = 1;
-            set_status(get_pid(), BLOCKED);
-            yield();
+            return available;
         }
 
-        while ((pipe->currentSize > 0 || (int)pipe->buffer[pipe->startPosition] == EOF_MARKER) && readBytes < len)
+        // Either pipe may be closed, and its slot reused, while the other one is waited on.
+        if (!pipe_is_alive(out, outId, outGeneration))
         {
-            buffer[readBytes] = pipe->buffer[pipe->startPosition];
+            return -1;
+        }
 
-            if ((int)buffer[readBytes++] == EOF_MARKER)
-            {
-                eofRead = 1;
-                break;
-            }
+        int64_t space = wait_for_space(out, outId);
+        if (space < 0)
+        {
+            return space;
+        }
 
-            pipe->currentSize--;
-            pipe->startPosition = (pipe->startPosition + 1) % PIPE_SIZE;
+        // Waiting for space may also have let other readers drain the input.
+        if (!pipe_is_alive(in, inId, inGeneration) || !pipe_is_alive(out, outId, outGeneration))
+        {
+            return -1;
+        }
+        if (in->currentSize == 0)
+        {
+            continue;
+        }
+
+        uint32_t moved = in->currentSize < (uint64_t)space ? in->currentSize : (uint32_t)space;
+        if (len < moved)
+        {
+            moved = (uint32_t)len;
         }
 
-        if (pipe->isBlocking)
+        uint32_t firstSpan = contiguous_data(in, moved);
+        produce_data(out, in->buffer + in->startPosition, firstSpan);
+        produce_data(out, in->buffer, moved - firstSpan);
+
+        if (consume)
         {
-            set_status(pipe->inputPid, READY);
-            pipe->isBlocking = 0;
+            consume_data(in, moved);
         }
+        return moved;
     }
+}
 
-    return readBytes;
+int64_t pipe_drain(uint16_t id, PipeSink sink, uint64_t len, uint8_t consume)
+{
+    Pipe *pipe = get_pipe_by_id(id);
+    if (pipe == NULL || pipe->readers == 0 || len == 0)
+    {
+        return -1;
+    }
+
+    int64_t available = wait_for_data(pipe, id);
+    if (available <= 0)
+    {
+        return available;
+    }
+
+    uint32_t drained = len < (uint64_t)available ? (uint32_t)len : (uint32_t)available;
+    uint32_t firstSpan = contiguous_data(pipe, drained);
+
+    if (sink != NULL)
+    {
+        sink(pipe->buffer + pipe->startPosition, firstSpan);
+        if (drained > firstSpan)
+        {
+            sink(pipe->buffer, drained - firstSpan);
+        }
+    }
+
+    if (consume)
+    {
+        consume_data(pipe, drained);
+    }
+    return drained;
 }
 
-int64_t pipe_write(uint16_t pid, uint16_t id, const char *buffer, uint64_t len)
+int8_t pipe_set_flags(uint16_t id, uint8_t flags)
 {
     Pipe *pipe = get_pipe_by_id(id);
-    if (pipe == NULL || pipe->inputPid != (int16_t)pid || len == 0)
+    if (pipe == NULL)
     {
         return -1;
     }
 
-    uint64_t writtenBytes = 0;
+    uint8_t old = pipe->flags;
+    pipe->flags = flags & O_NONBLOCK;
+    return (int8_t)old;
+}
+
+uint8_t pipe_poll(uint16_t id, uint8_t events, PollWaiter *waiter)
+{
+    Pipe *pipe = get_pipe_by_id(id);
+    if (pipe == NULL)
+    {
+        return POLLNVAL;
+    }
+
+    uint8_t revents = 0;
 
-    while (writtenBytes < len && (int)pipe->buffer[bufferPosition(pipe)] != EOF_MARKER)
+    if ((events & POLLIN) && (pipe->currentSize > 0 || pipe->writerClosed))
     {
+        revents |= POLLIN;
+    }
+    if ((events & POLLOUT) && (pipe->currentSize < pipe->size || pipe->buffer == NULL || readerGone(pipe)))
+    {
+        revents |= POLLOUT;
+    }
+    if (pipe->writerClosed || readerGone(pipe))
+    {
+        revents |= POLLHUP;
+    }
+
+    if (revents == 0 && waiter != NULL)
+    {
+        poll_wait_on(waiter, &pipe->pollQueue);
+    }
+    return revents;
+}
+
+// The slab may hand a freed pipe's memory to a new pipe under the same id, so the address alone proves nothing.
+static int8_t pipe_is_alive(Pipe *pipe, uint16_t id, uint32_t generation)
+{
+    return pipe == get_pipe_by_id(id) && pipe->generation == generation;
+}
+
+// Blocks until the pipe holds data; returns the bytes available, 0 at EOF or an error.
+static int64_t wait_for_data(Pipe *pipe, uint16_t id)
+{
+    uint32_t generation = pipe->generation;
 
-        if (pipe->currentSize >= PIPE_SIZE)
+    while (pipe->currentSize == 0 && !pipe->writerClosed)
+    {
+        if (pipe->flags & O_NONBLOCK)
         {
-            pipe->isBlocking = 1;
-            set_status(pid, BLOCKED);
-            yield();
+            return PIPE_WOULD_BLOCK;
         }
 
-        if (pipe != get_pipe_by_id(id))
+        process_block_on(&pipe->readQueue, BLOCK_PIPE);
+
+        if (!pipe_is_alive(pipe, id, generation))
         {
             return -1;
         }
+    }
 
-        while (pipe->currentSize < PIPE_SIZE && writtenBytes < len)
+    return pipe->currentSize;
+}
+
+// Blocks until the pipe has room, growing it under sustained backpressure; returns the free bytes or an error.
+static int64_t wait_for_space(Pipe *pipe, uint16_t id)
+{
+    if (pipe->buffer == NULL && alloc_pipe_buffer(pipe) != 0)
+    {
+        return -1;
+    }
+
+    uint32_t generation = pipe->generation;
+
+    while (pipe->currentSize >= pipe->size && !readerGone(pipe))
+    {
+        if (pipe->fullWaits >= PIPE_GROW_THRESHOLD && grow_pipe(pipe) == 0)
         {
-            pipe->buffer[bufferPosition(pipe)] = buffer[writtenBytes];
+            break;
+        }
 
-            if ((int)buffer[writtenBytes++] == EOF_MARKER)
-            {
-                break;
-            }
+        if (pipe->fullWaits < PIPE_GROW_THRESHOLD)
+        {
+            pipe->fullWaits++;
+        }
 
-            pipe->currentSize++;
+        if (pipe->flags & O_NONBLOCK)
+        {
+            return PIPE_WOULD_BLOCK;
         }
 
-        if (pipe->isBlocking)
+        process_block_on(&pipe->writeQueue, BLOCK_PIPE);
+
+        if (!pipe_is_alive(pipe, id, generation))
         {
-            set_status(pipe->outputPid, READY);
-            pipe->isBlocking = 0;
+            return -1;
         }
     }
 
-    return writtenBytes;
+    if (readerGone(pipe))
+    {
+        return -1;
+    }
+
+    return pipe->size - pipe->currentSize;
+}
+
+static uint32_t contiguous_data(Pipe *pipe, uint32_t len)
+{
+    uint32_t firstSpan = pipe->size - pipe->startPosition;
+    return firstSpan < len ? firstSpan : len;
+}
+
+static void produce_data(Pipe *pipe, const char *data, uint32_t len)
+{
+    if (len == 0)
+    {
+        return;
+    }
+
+    uint32_t end = bufferPosition(pipe);
+    uint32_t firstSpan = pipe->size - end;
+    if (firstSpan > len)
+    {
+        firstSpan = len;
+    }
+
+    memcpy(pipe->buffer + end, data, firstSpan);
+    memcpy(pipe->buffer, data + firstSpan, len - firstSpan);
+    pipe->currentSize += len;
+
+    process_wake_one(&pipe->readQueue);
+    poll_notify(&pipe->pollQueue);
+}
+
+static void consume_data(Pipe *pipe, uint32_t len)
+{
+    pipe->startPosition = (pipe->startPosition + len) % pipe->size;
+    pipe->currentSize -= len;
+
+    process_wake_one(&pipe->writeQueue);
+    if (pipe->currentSize > 0)
+    {
+        process_wake_one(&pipe->readQueue);
+    }
+    poll_notify(&pipe->pollQueue);
 }
 
 static int16_t get_pipe_index_by_id(uint16_t id)
@@ -292,25 +487,109 @@ static Pipe *get_pipe_by_id(uint16_t id)
     return pipeManager->pipes[index];
 }
 
-static Pipe *create_pipe(void)
+static Pipe *create_pipe(uint32_t capacity)
 {
-    Pipe *pipe = (Pipe *)mm_alloc(sizeof(Pipe));
+    Pipe *pipe = (Pipe *)kmem_cache_alloc(pipe_cache);
     if (pipe == NULL)
     {
         return NULL;
     }
 
-    pipe->startPosition = 0;
-    pipe->currentSize = 0;
-    pipe->inputPid = -1;
-    pipe->outputPid = -1;
-    pipe->isBlocking = 0;
-    memset(pipe->buffer, 0, PIPE_SIZE);
+    pipe->generation = ++lastGeneration;
+
+    if (capacity < PIPE_MIN_CAPACITY)
+    {
+        capacity = PIPE_MIN_CAPACITY;
+    }
+    if (capacity > PIPE_MAX_CAPACITY)
+    {
+        capacity = PIPE_MAX_CAPACITY;
+    }
+
+    // Power-of-two sizes keep every buffer an exact buddy block.
+    pipe->capacity = PIPE_MIN_CAPACITY;
+    while (pipe->capacity < capacity)
+    {
+        pipe->capacity <<= 1;
+    }
 
     return pipe;
 }
 
+static int8_t alloc_pipe_buffer(Pipe *pipe)
+{
+    uint32_t size = pipe->capacity < PIPE_INITIAL_SIZE ? pipe->capacity : PIPE_INITIAL_SIZE;
+
+    pipe->buffer = (char *)mm_alloc(size);
+    if (pipe->buffer == NULL)
+    {
+        return -1;
+    }
+
+    pipe->size = size;
+    return 0;
+}
+
+static int8_t grow_pipe(Pipe *pipe)
+{
+    if (pipe->size >= pipe->capacity)
+    {
+        return -1;
+    }
+
+    uint32_t newSize = pipe->size << 1;
+    char *newBuffer = (char *)mm_alloc(newSize);
+    if (newBuffer == NULL)
+    {
+        return -1;
+    }
+
+    uint32_t firstSpan = pipe->size - pipe->startPosition;
+    if (firstSpan > pipe->currentSize)
+    {
+        firstSpan = pipe->currentSize;
+    }
+
+    memcpy(newBuffer, pipe->buffer + pipe->startPosition, firstSpan);
+    memcpy(newBuffer + firstSpan, pipe->buffer, pipe->currentSize - firstSpan);
+    mm_free(pipe->buffer);
+
+    pipe->buffer = newBuffer;
+    pipe->size = newSize;
+    pipe->startPosition = 0;
+    pipe->fullWaits = 0;
+    return 0;
+}
+
+static void pipe_ctor(void *object)
+{
+    Pipe *pipe = (Pipe *)object;
+
+    pipe->buffer = NULL;
+    pipe->size = 0;
+    pipe->capacity = PIPE_DEFAULT_CAPACITY;
+    pipe->startPosition = 0;
+    pipe->currentSize = 0;
+    pipe->readers = 0;
+    pipe->writers = 0;
+    pipe->readerOpened = 0;
+    pipe->writerClosed = 0;
+    list_init(&pipe->readQueue);
+    list_init(&pipe->writeQueue);
+    list_init(&pipe->pollQueue);
+    pipe->flags = 0;
+    pipe->fullWaits = 0;
+}
+
 static void free_pipe(Pipe *pipe)
 {
-    mm_free(pipe);
+    process_wake_all(&pipe->readQueue);
+    process_wake_all(&pipe->writeQueue);
+    poll_detach_all(&pipe->pollQueue);
+
+    if (pipe->buffer != NULL)
+    {
+        mm_free(pipe->buffer);
+    }
+    kmem_cache_free(pipe_cache, pipe);
 }
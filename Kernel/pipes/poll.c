@@ -0,0 +1,154 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <poll.h>
+#include <pipe.h>
+#include <keyboardDriver.h>
+#include <scheduler.h>
+#include <timer.h>
+#include <time.h>
+#include <globals.h>
+#include <stddef.h>
+
+static uint8_t poll_fd(int16_t fd, uint8_t events, PollWaiter *waiter);
+static void poll_timeout(void *data);
+
+void poll_wait_on(PollWaiter *waiter, List *queue)
+{
+    waiter->queue = queue;
+    list_append(queue, &waiter->node);
+}
+
+void poll_notify(List *queue)
+{
+    for (ListNode *node = list_get_first(queue); node != NULL; node = list_next(queue, node))
+    {
+        Process *process = list_entry(node, PollWaiter, node)->process;
+        if (process->status == BLOCKED)
+        {
+            set_status(process->pid, READY);
+        }
+    }
+}
+
+// The object behind the queue is going away; its pollers must not touch it again.
+void poll_detach_all(List *queue)
+{
+    poll_notify(queue);
+
+    ListNode *node;
+    while ((node = list_get_first(queue)) != NULL)
+    {
+        list_remove(queue, node);
+        list_entry(node, PollWaiter, node)->queue = NULL;
+    }
+}
+
+void poll_release(Process *process)
+{
+    for (uint16_t i = 0; i < process->poll_count; i++)
+    {
+        PollWaiter *waiter = &process->poll_waiters[i];
+        if (waiter->queue != NULL)
+        {
+            list_remove(waiter->queue, &waiter->node);
+            waiter->queue = NULL;
+        }
+    }
+    process->poll_waiters = NULL;
+    process->poll_count = 0;
+}
+
+int32_t poll(PollFd *fds, uint32_t count, uint64_t timeout_ticks)
+{
+    if (fds == NULL || count > MAX_POLL_FDS)
+    {
+        return -1;
+    }
+
+    Process *current = get_current_process();
+    PollWaiter waiters[MAX_POLL_FDS];
+    uint64_t deadline = 0;
+
+    if (timeout_ticks != 0 && timeout_ticks != POLL_NO_TIMEOUT)
+    {
+        deadline = ticks_elapsed() + timeout_ticks + 1;
+    }
+
+    while (1)
+    {
+        uint8_t expired = timeout_ticks == 0 || (deadline != 0 && ticks_elapsed() >= deadline);
+        int32_t ready = 0;
+
+        // Register on every queue in the same pass that found nothing ready, so no wakeup is missed.
+        for (uint32_t i = 0; i < count; i++)
+        {
+            waiters[i].queue = NULL;
+            waiters[i].process = current;
+            fds[i].revents = poll_fd(fds[i].fd, fds[i].events, (ready || expired) ? NULL : &waiters[i]);
+            if (fds[i].revents)
+            {
+                ready++;
+            }
+        }
+
+        if (ready || expired)
+        {
+            current->poll_waiters = waiters;
+            current->poll_count = (uint16_t)count;
+            poll_release(current);
+            return ready;
+        }
+
+        current->poll_waiters = waiters;
+        current->poll_count = (uint16_t)count;
+        if (deadline != 0)
+        {
+            timer_arm(&current->sleep_timer, deadline, poll_timeout, current);
+        }
+
+        block_process(current->pid, BLOCK_POLL);
+        yield();
+
+        timer_cancel(&current->sleep_timer);
+        poll_release(current);
+    }
+}
+
+static uint8_t poll_fd(int16_t fd, uint8_t events, PollWaiter *waiter)
+{
+    int16_t actual_fd = fd;
+
+    if (fd >= 0 && fd < BUILT_IN_DESCRIPTORS)
+    {
+        actual_fd = get_process_fd((uint8_t)fd);
+    }
+
+    if (actual_fd >= BUILT_IN_DESCRIPTORS)
+    {
+        return pipe_poll((uint16_t)actual_fd, events, waiter);
+    }
+
+    switch (actual_fd)
+    {
+    case DEV_NULL:
+        return events & (POLLIN | POLLOUT);
+    case STDIN:
+        return keyboard_poll(events, waiter);
+    case STDOUT:
+    case STDERR:
+        return events & POLLOUT;
+    default:
+        return POLLNVAL;
+    }
+}
+
+static void poll_timeout(void *data)
+{
+    Process *process = (Process *)data;
+
+    if (process->status == BLOCKED)
+    {
+        set_status(process->pid, READY);
+    }
+}
@@ -8,6 +8,10 @@
 #include <pipe.h>
 #include <globals.h>
 #include <list.h>
+#include <slab.h>
+#include <smp.h>
+#include <interrupts.h>
+#include <time.h>
 #include <stddef.h>
 
 extern void *_initialize_stack_frame(void *wrapper, void *code, void *stack_top, void *args);
@@ -16,6 +20,13 @@ extern int32_t kill_current_process(int32_t retval);
 static void process_wrapper(MainFunction code, char **args);
 static char **allocate_arguments(char **args);
 
+static KmemCache *name_cache;
+
+void init_process_caches(void)
+{
+    name_cache = kmem_cache_create("process_name", PROCESS_NAME_LEN, NULL);
+}
+
 int8_t init_process(Process *process, uint16_t pid, uint16_t parent_pid,
                     MainFunction code, char **args, char *name,
                     uint8_t priority, int16_t fds[3], uint8_t unkillable)
@@ -26,30 +37,64 @@ int8_t init_process(Process *process, uint16_t pid, uint16_t parent_pid,
     process->status = READY;
     process->unkillable = unkillable;
     process->return_value = 0;
+    process->is_idle = 0;
+    process->cpu = NO_CPU;
+    process->release_pending = 0;
 
     process->quantum_consumed_count = 0;
 
+    process->last_cpu = NO_CPU;
+    process->state_since = ticks_elapsed();
+    process->run_ticks = 0;
+    process->ready_ticks = 0;
+    process->blocked_ticks = 0;
+    process->voluntary_switches = 0;
+    process->involuntary_switches = 0;
+
     process->waiting_for_pid = 0;
+    process->block_reason = 0;
     list_init(&process->zombie_children);
 
+    list_node_init(&process->ready_node);
+    list_node_init(&process->zombie_node);
+    list_node_init(&process->wait_node);
+    process->wait_queue = NULL;
+    timer_init_entry(&process->sleep_timer);
+    process->poll_waiters = NULL;
+    process->poll_count = 0;
+    for (int i = 0; i < MAX_PROCESS_SHM; i++)
+        process->shm_ids[i] = -1;
+    for (int i = 0; i < MAX_PROCESS_RWLOCKS; i++)
+        process->rwlock_ids[i] = -1;
+    process->futex_key = 0;
+    process->inherited_priority = 0;
+    list_init(&process->owned_mutexes);
+    process->waiting_semaphore = NULL;
+
     process->stack_base = mm_alloc(4096);
     if (process->stack_base == NULL)
     {
         return -1;
     }
 
-    process->name = (char *)mm_alloc(strlen(name) + 1);
+    process->name = (char *)kmem_cache_alloc(name_cache);
     if (process->name == NULL)
     {
         mm_free(process->stack_base);
         return -1;
     }
-    strcpy(process->name, name);
+
+    int i;
+    for (i = 0; i < PROCESS_NAME_LEN - 1 && name[i] != '\0'; i++)
+    {
+        process->name[i] = name[i];
+    }
+    process->name[i] = '\0';
 
     process->argv = allocate_arguments(args);
     if (args != NULL && process->argv == NULL)
     {
-        mm_free(process->name);
+        kmem_cache_free(name_cache, process->name);
         mm_free(process->stack_base);
         return -1;
     }
@@ -67,7 +112,7 @@ int8_t init_process(Process *process, uint16_t pid, uint16_t parent_pid,
         {
 
             uint8_t mode = (i == 0) ? READ : WRITE;
-            pipe_open(process->pid, fds[i], mode);
+            pipe_open(fds[i], mode);
         }
     }
 
@@ -82,17 +127,61 @@ void free_process(Process *process)
         int16_t fd = process->file_descriptors[i];
         if (fd >= BUILT_IN_DESCRIPTORS)
         {
-            pipe_close(process->pid, fd);
+            pipe_close(fd, i == 0 ? READ : WRITE);
         }
     }
 
     mm_free(process->stack_base);
     if (process->name)
-        mm_free(process->name);
+        kmem_cache_free(name_cache, process->name);
     if (process->argv)
         mm_free(process->argv);
 }
 
+void process_wait_on(Process *process, List *queue)
+{
+    process_stop_waiting(process);
+    process->wait_queue = queue;
+    list_append(queue, &process->wait_node);
+}
+
+void process_stop_waiting(Process *process)
+{
+    if (process == NULL || process->wait_queue == NULL)
+        return;
+
+    list_remove(process->wait_queue, &process->wait_node);
+    process->wait_queue = NULL;
+}
+
+// Blocks the current process on a wait queue; callers re-check their condition once it returns.
+void process_block_on(List *queue, uint8_t reason)
+{
+    Process *current = get_current_process();
+
+    process_wait_on(current, queue);
+    block_process(current->pid, reason);
+    yield();
+    process_stop_waiting(current);
+}
+
+void process_wake_one(List *queue)
+{
+    ListNode *node = list_get_first(queue);
+    if (node == NULL)
+        return;
+
+    Process *process = list_entry(node, Process, wait_node);
+    process_stop_waiting(process);
+    set_status(process->pid, READY);
+}
+
+void process_wake_all(List *queue)
+{
+    while (!list_is_empty(queue))
+        process_wake_one(queue);
+}
+
 int16_t get_process_fd(uint8_t fd_index)
 {
     if (fd_index >= 3)
@@ -107,34 +196,45 @@ int16_t get_process_fd(uint8_t fd_index)
 
 int32_t get_process_info(ProcessInfo *info_array, uint32_t max_count)
 {
+    // Without a buffer, report how many entries a full snapshot needs.
     if (!info_array || max_count == 0)
-        return -1;
+        return get_process_count();
 
     uint16_t foreground_pid = get_foreground_process_pid();
+    uint64_t now = ticks_elapsed();
     uint32_t count = 0;
 
-    for (int i = 0; i < MAX_PROCESSES && count < max_count; i++)
+    for (int32_t pid = get_next_used_pid(0); pid >= 0 && count < max_count; pid = get_next_used_pid(pid + 1))
     {
-        Process *process = get_process_by_pid(i);
+        Process *process = get_process_by_pid(pid);
         if (process != NULL)
         {
             info_array[count].pid = process->pid;
             info_array[count].parent_pid = process->parent_pid;
 
             int j;
-            for (j = 0; j < 63 && process->name[j] != '\0'; j++)
+            for (j = 0; j < PROCESS_NAME_LEN - 1 && process->name[j] != '\0'; j++)
             {
                 info_array[count].name[j] = process->name[j];
             }
             info_array[count].name[j] = '\0';
 
-            info_array[count].priority = process->priority;
+            info_array[count].priority = get_effective_priority(process);
             info_array[count].status = process->status;
             info_array[count].stack_base = process->stack_base;
             info_array[count].stack_pos = process->stack_pos;
 
             info_array[count].is_foreground = (process->pid == foreground_pid) ? 1 : 0;
 
+            // The state the process is in right now has not been charged yet.
+            uint64_t current_state = now - process->state_since;
+            info_array[count].last_cpu = process->last_cpu;
+            info_array[count].run_ticks = process->run_ticks + (process->status == RUNNING ? current_state : 0);
+            info_array[count].ready_ticks = process->ready_ticks + (process->status == READY ? current_state : 0);
+            info_array[count].blocked_ticks = process->blocked_ticks + (process->status == BLOCKED ? current_state : 0);
+            info_array[count].voluntary_switches = process->voluntary_switches;
+            info_array[count].involuntary_switches = process->involuntary_switches;
+
             count++;
         }
     }
@@ -142,8 +242,11 @@ int32_t get_process_info(ProcessInfo *info_array, uint32_t max_count)
     return count;
 }
 
+// Entered through an interrupt epilogue, which has already released the kernel lock.
 static void process_wrapper(MainFunction code, char **args)
 {
+    _sti();
+
     int argc = 0;
     if (args)
     {
@@ -151,6 +254,10 @@ static void process_wrapper(MainFunction code, char **args)
             argc++;
     }
     int retval = code(argc, args);
+
+    // Same state a syscall runs in: an IRQ taking the lock again on this CPU would deadlock.
+    _cli();
+    kernel_lock();
     kill_current_process(retval);
 }
 
@@ -5,209 +5,266 @@
 #include <scheduler.h>
 #include <list.h>
 #include <memoryManager.h>
+#include <slab.h>
 #include <pipe.h>
 #include <globals.h>
 #include <consoleDriver.h>
-
-static uint16_t get_next_pid(void);
+#include <timer.h>
+#include <time.h>
+#include <kernelInfo.h>
+#include <poll.h>
+#include <shm.h>
+#include <semaphores.h>
+#include <syncObjects.h>
+
+static Process *get_next_process(void);
+static Process *spawn_process(MainFunction code, char **args, char *name,
+                              uint8_t priority, int16_t fds[3], uint8_t unkillable);
+static int32_t terminate_process(Process *process, int32_t retval);
+static void kill_foreground_processes(void);
+static void preempt_process(Process *process);
+static void wake_idle_cpu(void);
+static void wake_sleeping_process(void *data);
+static void ready_enqueue(Process *process);
+static void ready_enqueue_front(Process *process);
+static void ready_dequeue(Process *process);
+static void release_process(Process *process);
+static void destroy_process(Process *process);
+static int32_t alloc_pid(void);
+static void change_status(Process *process, ProcessStatus new_status);
+static int32_t find_free_pid(uint16_t from);
+static void free_pid(uint16_t pid);
 
 static Scheduler scheduler;
+static KmemCache *process_cache;
+
+static inline CpuScheduler *this_cpu(void)
+{
+    return &scheduler.cpus[smp_cpu_index()];
+}
 
 void scheduler_init()
 {
-    for (int i = 0; i < MAX_PROCESSES; i++)
+    process_cache = kmem_cache_create("process", sizeof(Process), NULL);
+    init_process_caches();
+
+    for (int i = 0; i < PID_CHUNKS; i++)
     {
-        scheduler.processes[i] = NULL;
+        scheduler.pid_chunks[i] = NULL;
+        scheduler.pid_bitmap[i] = 0;
     }
+    scheduler.full_pid_words = 0;
 
     for (int i = 0; i < NUM_PRIORITIES; i++)
     {
         list_init(&scheduler.ready_queues[i]);
     }
 
-    list_init(&scheduler.blocked_queue);
-    scheduler.current_pid = 0;
-    scheduler.next_unused_pid = 0;
+    for (int i = 0; i < MAX_CPUS; i++)
+    {
+        scheduler.cpus[i].current = NULL;
+        scheduler.cpus[i].idle = NULL;
+        scheduler.cpus[i].remaining_quantum = 1;
+        scheduler.cpus[i].initial_quantum = 0;
+        scheduler.cpus[i].started = 0;
+        scheduler.cpus[i].yielded = 0;
+    }
+
+    scheduler.ready_bitmap = 0;
+    scheduler.next_pid = 0;
     scheduler.num_processes = 0;
-    scheduler.remaining_quantum = 1;
     scheduler.foreground_pid = 0;
     scheduler.current_priority_level = NUM_PRIORITIES - 1;
 }
 
 void *schedule(void *current_rsp)
 {
-    static int first_time = 1;
+    uint8_t cpu_index = smp_cpu_index();
+    CpuScheduler *cpu = &scheduler.cpus[cpu_index];
+    Process *current_process = cpu->current;
+
+    if (current_process == NULL)
+    {
+        return current_rsp;
+    }
 
     if (scheduler.kill_fg_flag)
     {
         scheduler.kill_fg_flag = 0;
-
-        if (scheduler.current_pid != IDLE_PID &&
-            scheduler.processes[scheduler.current_pid] != NULL)
-        {
-            Process *current = (Process *)scheduler.processes[scheduler.current_pid]->data;
-
-            if (current->file_descriptors[0] == STDIN)
-            {
-                kill_current_process(-1);
-            }
-        }
+        kill_foreground_processes();
     }
 
-    scheduler.remaining_quantum--;
+    cpu->remaining_quantum--;
 
-    if (!scheduler.num_processes || scheduler.remaining_quantum > 0)
+    if (cpu->remaining_quantum > 0)
     {
         return current_rsp;
     }
 
-    if (scheduler.processes[scheduler.current_pid] != NULL)
+    if (cpu->started)
     {
-        Process *current_process = (Process *)scheduler.processes[scheduler.current_pid]->data;
+        current_process->stack_pos = current_rsp;
+    }
+    else
+    {
+        cpu->started = 1;
+    }
 
-        if (!first_time)
-        {
-            current_process->stack_pos = current_rsp;
-        }
-        else
+    // Blocking, exiting or yielding gives the CPU up; anything else is a preemption.
+    uint8_t voluntary = cpu->yielded || current_process->status != RUNNING;
+    cpu->yielded = 0;
+
+    if (current_process->status == RUNNING)
+    {
+        change_status(current_process, READY);
+
+        if (cpu->remaining_quantum == 0 && cpu->initial_quantum > 0)
         {
-            first_time = 0;
+            current_process->quantum_consumed_count++;
+
+            if (current_process->quantum_consumed_count >= AGING_THRESHOLD && current_process->priority < NUM_PRIORITIES - 1)
+            {
+                current_process->priority++;
+                current_process->quantum_consumed_count = 0;
+                trace_record(TRACE_AGING, current_process->pid, current_process->priority);
+            }
         }
 
-        if (current_process->status == RUNNING)
+        if (!current_process->is_idle)
         {
-            current_process->status = READY;
-
-            uint8_t rotated = 0;
+            ready_enqueue(current_process);
+        }
+    }
 
-            if (scheduler.remaining_quantum == 0 && scheduler.initial_quantum > 0)
-            {
-                current_process->quantum_consumed_count++;
+    current_process->cpu = NO_CPU;
 
-                if (current_process->quantum_consumed_count >= AGING_THRESHOLD && current_process->priority < NUM_PRIORITIES - 1)
-                {
-                    uint8_t new_priority = current_process->priority + 1;
-                    set_priority(scheduler.current_pid, new_priority);
-                    rotated = 1;
+    if (current_process->release_pending)
+    {
+        destroy_process(current_process);
+        current_process = NULL;
+    }
 
-                    current_process->quantum_consumed_count = 0;
-                }
-            }
+    Process *next_process = get_next_process();
+    if (next_process == NULL)
+    {
+        next_process = cpu->idle;
+        tick_stop();
+    }
+    else
+    {
+        tick_resume();
 
-            if (!rotated)
-            {
-                set_priority(scheduler.current_pid, current_process->priority);
-            }
+        if (scheduler.ready_bitmap != 0)
+        {
+            wake_idle_cpu();
         }
     }
 
-    scheduler.current_pid = get_next_pid();
-    Process *next_process = (Process *)scheduler.processes[scheduler.current_pid]->data;
+    if (current_process != NULL && next_process != current_process)
+    {
+        if (voluntary)
+            current_process->voluntary_switches++;
+        else
+            current_process->involuntary_switches++;
+        trace_record(TRACE_SWITCH_OUT, current_process->pid, voluntary);
+    }
+
+    // A process released above has already left through its TRACE_KILL event.
+    if (next_process != current_process)
+        trace_record(TRACE_SWITCH_IN, next_process->pid, get_effective_priority(next_process));
 
-    scheduler.initial_quantum = CALCULATE_QUANTUM(next_process->priority);
-    scheduler.remaining_quantum = scheduler.initial_quantum;
+    cpu->current = next_process;
+    cpu->initial_quantum = next_process->is_idle ? 1 : CALCULATE_QUANTUM(get_effective_priority(next_process));
+    cpu->remaining_quantum = cpu->initial_quantum;
 
-    next_process->status = RUNNING;
+    next_process->cpu = cpu_index;
+    next_process->last_cpu = cpu_index;
+    change_status(next_process, RUNNING);
+    kernel_info_switch(cpu_index, next_process->pid);
     return next_process->stack_pos;
 }
 
 int16_t create_process(MainFunction code, char **args, char *name,
                        uint8_t priority, int16_t fds[3], uint8_t unkillable)
 {
-    if (scheduler.num_processes >= MAX_PROCESSES)
-        return -1;
-
-    if (priority >= NUM_PRIORITIES)
-        priority = NUM_PRIORITIES - 1;
-
-    Process *process = (Process *)mm_alloc(sizeof(Process));
+    Process *process = spawn_process(code, args, name, priority, fds, unkillable);
     if (process == NULL)
     {
         return -1;
     }
 
-    if (init_process(process, scheduler.next_unused_pid, scheduler.current_pid,
-                     code, args, name, priority, fds, unkillable) != 0)
-    {
-        mm_free(process);
-        return -1;
-    }
-
-    Node *node;
-    if (process->pid != IDLE_PID)
-    {
-        node = list_append(&scheduler.ready_queues[priority], process);
-        if (node == NULL)
-        {
-            free_process(process);
-            mm_free(process);
-            return -1;
-        }
-    }
-    else
-    {
+    ready_enqueue(process);
+    wake_idle_cpu();
+    return process->pid;
+}
 
-        node = (Node *)mm_alloc(sizeof(Node));
-        if (node == NULL)
-        {
-            free_process(process);
-            mm_free(process);
-            return -1;
-        }
-        node->data = process;
-        node->prev = node->next = NULL;
-    }
+int16_t create_idle_process(MainFunction code, uint8_t cpu)
+{
+    int16_t default_fds[3] = {STDIN, STDOUT, STDERR};
 
-    scheduler.processes[process->pid] = node;
+    if (cpu >= MAX_CPUS)
+        return -1;
 
-    while (scheduler.processes[scheduler.next_unused_pid] != NULL)
+    Process *process = spawn_process(code, NULL, "idle", 0, default_fds, 1);
+    if (process == NULL)
     {
-        scheduler.next_unused_pid = (scheduler.next_unused_pid + 1) % MAX_PROCESSES;
+        return -1;
     }
 
-    scheduler.num_processes++;
+    process->is_idle = 1;
+    scheduler.cpus[cpu].idle = process;
+    scheduler.cpus[cpu].current = process;
     return process->pid;
 }
 
 int8_t set_priority(uint16_t pid, uint8_t new_priority)
 {
-    if (pid >= MAX_PROCESSES || scheduler.processes[pid] == NULL || pid == IDLE_PID)
+    Process *process = get_process_by_pid(pid);
+    if (process == NULL || process->is_idle)
         return -1;
 
     if (new_priority >= NUM_PRIORITIES)
         return -1;
 
-    Node *node = scheduler.processes[pid];
-    Process *process = (Process *)node->data;
-
-    if (process->status == READY || process->status == RUNNING)
+    if (process->status == READY)
     {
-
-        list_remove(&scheduler.ready_queues[process->priority], node);
-
-        node = list_append(&scheduler.ready_queues[new_priority], process);
-        if (node == NULL)
-        {
-            scheduler.processes[pid] = NULL;
-            scheduler.num_processes--;
-            free_process(process);
-            mm_free(process);
-            return -1;
-        }
-        scheduler.processes[pid] = node;
+        ready_dequeue(process);
+        process->priority = new_priority;
+        ready_enqueue(process);
     }
 
     process->priority = new_priority;
     return new_priority;
 }
 
+uint8_t get_effective_priority(Process *process)
+{
+    return process->priority > process->inherited_priority ? process->priority : process->inherited_priority;
+}
+
+// A boost from a priority-inheritance mutex; the ready queue follows the effective priority.
+void set_inherited_priority(Process *process, uint8_t priority)
+{
+    if (priority >= NUM_PRIORITIES)
+        priority = NUM_PRIORITIES - 1;
+
+    if (process->status == READY)
+    {
+        ready_dequeue(process);
+        process->inherited_priority = priority;
+        ready_enqueue(process);
+        return;
+    }
+
+    process->inherited_priority = priority;
+}
+
 int8_t set_status(uint16_t pid, ProcessStatus new_status)
 {
-    if (pid >= MAX_PROCESSES || scheduler.processes[pid] == NULL || pid == IDLE_PID)
+    Process *process = get_process_by_pid(pid);
+    if (process == NULL || process->is_idle)
         return -1;
 
-    Node *node = scheduler.processes[pid];
-    Process *process = (Process *)node->data;
     ProcessStatus old_status = process->status;
 
     if (new_status == RUNNING || new_status == ZOMBIE || old_status == ZOMBIE)
@@ -216,88 +273,304 @@ int8_t set_status(uint16_t pid, ProcessStatus new_status)
     if (new_status == old_status)
         return new_status;
 
-    process->status = new_status;
+    // A running process is already runnable; it is requeued when it switches out.
+    if (new_status == READY && old_status == RUNNING)
+        return new_status;
 
     if (new_status == BLOCKED)
     {
-        uint8_t old_priority = process->priority;
+        if (old_status == READY)
+        {
+            ready_dequeue(process);
+        }
+
         if (process->priority > 0)
         {
             process->priority--;
         }
 
         process->quantum_consumed_count = 0;
+        change_status(process, BLOCKED);
+        trace_record(TRACE_BLOCK, process->pid, process->block_reason);
+        preempt_process(process);
+        return new_status;
+    }
 
-        list_remove(&scheduler.ready_queues[old_priority], node);
-        node = list_append(&scheduler.blocked_queue, process);
-        if (node == NULL)
+    if (old_status == BLOCKED && new_status == READY)
+    {
+        process->priority = NUM_PRIORITIES - 1;
+        trace_record(TRACE_UNBLOCK, process->pid, process->block_reason);
+        process->block_reason = BLOCK_OTHER;
+
+        // Still on its CPU: blocked and woken before it could switch away. The scheduler won't
+        // switch it in again, so close the wakeup here with a zero-latency SWITCH_IN.
+        if (process->cpu != NO_CPU)
         {
-            scheduler.processes[pid] = NULL;
-            scheduler.num_processes--;
-            free_process(process);
-            mm_free(process);
-            return -1;
+            trace_record(TRACE_SWITCH_IN, process->pid, get_effective_priority(process));
+            change_status(process, RUNNING);
+            return new_status;
         }
-        scheduler.processes[pid] = node;
+
+        ready_enqueue_front(process);
+        this_cpu()->remaining_quantum = 0;
+        wake_idle_cpu();
     }
-    else if (old_status == BLOCKED && new_status == READY)
+
+    change_status(process, new_status);
+    return new_status;
+}
+
+// set_status() for blocking, tagging the trace with what the process waits on.
+int8_t block_process(uint16_t pid, uint8_t reason)
+{
+    Process *process = get_process_by_pid(pid);
+    if (process != NULL && process->status != BLOCKED)
+        process->block_reason = reason;
+
+    return set_status(pid, BLOCKED);
+}
+
+int32_t kill_process(uint16_t pid, int32_t retval)
+{
+    Process *process = get_process_by_pid(pid);
+    if (process == NULL)
+        return -1;
+
+    int32_t result = terminate_process(process, retval);
+
+    if (result == 0 && process == get_current_process())
     {
+        yield();
+    }
 
-        list_remove(&scheduler.blocked_queue, node);
-        process->priority = NUM_PRIORITIES - 1;
-        node = list_prepend(&scheduler.ready_queues[process->priority], process);
-        if (node == NULL)
+    return result;
+}
+
+int32_t kill_current_process(int32_t retval)
+{
+    Process *current_process = get_current_process();
+    int32_t result = terminate_process(current_process, retval);
+
+    if (current_process->status == ZOMBIE)
+    {
+        yield();
+    }
+
+    return result;
+}
+
+void kill_foreground_process(void)
+{
+    scheduler.kill_fg_flag = 1;
+}
+
+uint16_t get_pid()
+{
+    Process *current_process = get_current_process();
+    return current_process != NULL ? current_process->pid : 0;
+}
+
+void yield()
+{
+    CpuScheduler *cpu = this_cpu();
+    Process *current_process = cpu->current;
+
+    if (current_process != NULL && !current_process->is_idle && cpu->initial_quantum > 0)
+    {
+        if (current_process->priority > 0)
         {
-            scheduler.processes[pid] = NULL;
-            scheduler.num_processes--;
-            free_process(process);
-            mm_free(process);
-            return -1;
+            current_process->priority--;
         }
-        scheduler.processes[pid] = node;
-        scheduler.remaining_quantum = 0;
+
+        current_process->quantum_consumed_count = 0;
     }
 
-    return new_status;
+    cpu->remaining_quantum = 0;
+    cpu->yielded = 1;
+    __asm__ volatile("int $0x81");
+
+    // Whichever epilogue resumed us dropped the lock on the way out.
+    kernel_lock();
 }
 
-int32_t kill_process(uint16_t pid, int32_t retval)
+int32_t waitpid(uint16_t pid)
 {
-    if (pid >= MAX_PROCESSES || scheduler.processes[pid] == NULL)
+
+    Process *child_process = get_process_by_pid(pid);
+    if (child_process == NULL)
         return -1;
 
-    Node *node = scheduler.processes[pid];
-    Process *process = (Process *)node->data;
+    Process *parent = get_current_process();
 
-    if (process->status == ZOMBIE || process->unkillable)
+    if (child_process->parent_pid != parent->pid)
         return -1;
 
-    if (process->status == BLOCKED)
+    parent->waiting_for_pid = pid;
+
+    scheduler.foreground_pid = pid;
+
+    if (child_process->status != ZOMBIE)
     {
-        list_remove(&scheduler.blocked_queue, node);
+        block_process(parent->pid, BLOCK_WAITPID);
+        yield();
     }
-    else
+
+    int32_t retval = child_process->return_value;
+
+    list_remove(&parent->zombie_children, &child_process->zombie_node);
+
+    release_process(child_process);
+
+    parent->waiting_for_pid = 0;
+    scheduler.foreground_pid = 0;
+
+    return retval;
+}
+
+void sleep_current_process(uint64_t ticks)
+{
+    Process *current_process = get_current_process();
+
+    if (ticks == 0)
     {
-        list_remove(&scheduler.ready_queues[process->priority], node);
+        yield();
+        return;
     }
 
-    while (!list_is_empty(&process->zombie_children))
+    // One extra tick: the current one is already partly over.
+    uint64_t deadline = ticks_elapsed() + ticks + 1;
+
+    while (ticks_elapsed() < deadline)
     {
-        Node *zombie_node = list_get_first(&process->zombie_children);
-        Process *zombie_child = (Process *)zombie_node->data;
-        uint16_t zombie_pid = zombie_child->pid;
+        timer_arm(&current_process->sleep_timer, deadline, wake_sleeping_process, current_process);
+        block_process(current_process->pid, BLOCK_SLEEP);
+        yield();
+    }
 
-        list_remove(&process->zombie_children, zombie_node);
+    timer_cancel(&current_process->sleep_timer);
+}
+
+Process *get_current_process()
+{
+    return this_cpu()->current;
+}
+
+Process *get_process_by_pid(uint16_t pid)
+{
+    if (pid >= MAX_PIDS)
+        return NULL;
+
+    Process **chunk = scheduler.pid_chunks[pid / PID_CHUNK_SIZE];
+    return chunk != NULL ? chunk[pid % PID_CHUNK_SIZE] : NULL;
+}
+
+uint16_t get_process_count(void)
+{
+    return scheduler.num_processes;
+}
+
+int32_t get_next_used_pid(uint16_t from)
+{
+    if (from >= MAX_PIDS)
+        return -1;
+
+    uint16_t word = from / PID_CHUNK_SIZE;
+    uint64_t used = scheduler.pid_bitmap[word] & (~0ULL << (from % PID_CHUNK_SIZE));
+
+    while (used == 0)
+    {
+        if (++word >= PID_CHUNKS)
+            return -1;
+        used = scheduler.pid_bitmap[word];
+    }
+
+    return word * PID_CHUNK_SIZE + __builtin_ctzll(used);
+}
+
+uint16_t get_foreground_process_pid()
+{
+    return scheduler.foreground_pid;
+}
+
+static Process *get_next_process()
+{
+    if (scheduler.ready_bitmap == 0)
+        return NULL;
+
+    uint32_t eligible = scheduler.ready_bitmap & ((2u << scheduler.current_priority_level) - 1);
+    if (eligible == 0)
+        eligible = scheduler.ready_bitmap;
+
+    int lvl = 31 - __builtin_clz(eligible);
+    scheduler.current_priority_level = (lvl - 1 + NUM_PRIORITIES) % NUM_PRIORITIES;
+
+    Process *process = list_entry(list_get_first(&scheduler.ready_queues[lvl]), Process, ready_node);
+    ready_dequeue(process);
+    return process;
+}
+
+static Process *spawn_process(MainFunction code, char **args, char *name,
+                              uint8_t priority, int16_t fds[3], uint8_t unkillable)
+{
+    if (priority >= NUM_PRIORITIES)
+        priority = NUM_PRIORITIES - 1;
+
+    Process *process = (Process *)kmem_cache_alloc(process_cache);
+    if (process == NULL)
+    {
+        return NULL;
+    }
 
-        scheduler.processes[zombie_pid] = NULL;
-        scheduler.num_processes--;
+    int32_t pid = alloc_pid();
+    if (pid < 0)
+    {
+        kmem_cache_free(process_cache, process);
+        return NULL;
+    }
 
-        free_process(zombie_child);
-        mm_free(zombie_child);
+    if (init_process(process, (uint16_t)pid, get_pid(),
+                     code, args, name, priority, fds, unkillable) != 0)
+    {
+        free_pid((uint16_t)pid);
+        kmem_cache_free(process_cache, process);
+        return NULL;
     }
 
-    process->status = ZOMBIE;
+    scheduler.pid_chunks[pid / PID_CHUNK_SIZE][pid % PID_CHUNK_SIZE] = process;
+    scheduler.num_processes++;
+    return process;
+}
+
+static int32_t terminate_process(Process *process, int32_t retval)
+{
+    if (process->status == ZOMBIE || process->unkillable)
+        return -1;
+
+    uint16_t pid = process->pid;
+    trace_record(TRACE_KILL, pid, 0);
+
+    if (process->status == READY)
+    {
+        ready_dequeue(process);
+    }
+
+    sync_release(process);
+    process_stop_waiting(process);
+    timer_cancel(&process->sleep_timer);
+    poll_release(process);
+    shm_release(process);
+    sem_release_owned(process);
+
+    ListNode *zombie_node;
+    while ((zombie_node = list_get_first(&process->zombie_children)) != NULL)
+    {
+        list_remove(&process->zombie_children, zombie_node);
+        release_process(list_entry(zombie_node, Process, zombie_node));
+    }
+
+    change_status(process, ZOMBIE);
     process->return_value = retval;
+    preempt_process(process);
 
     for (int i = 0; i < 3; i++)
     {
@@ -305,7 +578,7 @@ int32_t kill_process(uint16_t pid, int32_t retval)
         if (fd >= BUILT_IN_DESCRIPTORS)
         {
 
-            pipe_close(pid, fd);
+            pipe_close(fd, i == 0 ? READ : WRITE);
             process->file_descriptors[i] = -1;
         }
     }
@@ -316,175 +589,190 @@ int32_t kill_process(uint16_t pid, int32_t retval)
     }
 
     uint16_t parent_pid = process->parent_pid;
-    if (parent_pid < MAX_PROCESSES && scheduler.processes[parent_pid] != NULL)
-    {
-        Process *parent = (Process *)scheduler.processes[parent_pid]->data;
-
-        if (parent->status != ZOMBIE)
-        {
-
-            Node *zombie_node = list_append(&parent->zombie_children, process);
-            if (zombie_node == NULL)
-            {
+    Process *parent = get_process_by_pid(parent_pid);
 
-                scheduler.processes[pid] = NULL;
-                scheduler.num_processes--;
-                free_process(process);
-                mm_free(process);
-                return 0;
-            }
-            scheduler.processes[pid] = zombie_node;
+    if (parent != NULL && parent->status != ZOMBIE)
+    {
+        list_append(&parent->zombie_children, &process->zombie_node);
 
-            if (parent->waiting_for_pid == pid && parent->status == BLOCKED)
-            {
-                set_status(parent_pid, READY);
-            }
-        }
-        else
+        if (parent->waiting_for_pid == pid && parent->status == BLOCKED)
         {
-
-            scheduler.processes[pid] = NULL;
-            scheduler.num_processes--;
-            free_process(process);
-            mm_free(process);
+            set_status(parent_pid, READY);
         }
     }
     else
     {
-
-        scheduler.processes[pid] = NULL;
-        scheduler.num_processes--;
-        free_process(process);
-        mm_free(process);
-    }
-
-    if (pid == scheduler.current_pid)
-    {
-        yield();
+        release_process(process);
     }
 
     return 0;
 }
 
-int32_t kill_current_process(int32_t retval)
+static void kill_foreground_processes(void)
 {
-    return kill_process(scheduler.current_pid, retval);
-}
+    for (uint8_t i = 0; i < smp_cpu_count(); i++)
+    {
+        Process *process = scheduler.cpus[i].current;
 
-void kill_foreground_process(void)
-{
-    scheduler.kill_fg_flag = 1;
+        if (process != NULL && !process->is_idle && process->status == RUNNING &&
+            process->file_descriptors[0] == STDIN)
+        {
+            terminate_process(process, -1);
+        }
+    }
 }
 
-uint16_t get_pid()
+static void preempt_process(Process *process)
 {
-    return scheduler.current_pid;
+    if (process->cpu == NO_CPU)
+        return;
+
+    scheduler.cpus[process->cpu].remaining_quantum = 0;
+    smp_reschedule(process->cpu);
 }
 
-void yield()
+static void wake_idle_cpu(void)
 {
-    if (scheduler.processes[scheduler.current_pid] != NULL && scheduler.initial_quantum > 0)
+    uint8_t self = smp_cpu_index();
+
+    for (uint8_t i = 0; i < smp_cpu_count(); i++)
     {
-        Process *current_process = (Process *)scheduler.processes[scheduler.current_pid]->data;
+        Process *running = scheduler.cpus[i].current;
 
-        if (current_process->priority > 0)
+        if (i != self && running != NULL && running->is_idle && scheduler.cpus[i].started)
         {
-            set_priority(scheduler.current_pid, current_process->priority - 1);
+            scheduler.cpus[i].remaining_quantum = 0;
+            smp_reschedule(i);
+            return;
         }
-
-        current_process->quantum_consumed_count = 0;
     }
-
-    scheduler.remaining_quantum = 0;
-    __asm__ volatile("int $0x20");
 }
 
-int32_t waitpid(uint16_t pid)
+static void wake_sleeping_process(void *data)
 {
+    Process *process = (Process *)data;
 
-    if (pid >= MAX_PROCESSES || scheduler.processes[pid] == NULL)
-        return -1;
+    if (process->status == BLOCKED)
+    {
+        set_status(process->pid, READY);
+    }
+}
 
-    Node *child_node = scheduler.processes[pid];
-    Process *child_process = (Process *)child_node->data;
+static void ready_enqueue(Process *process)
+{
+    uint8_t priority = get_effective_priority(process);
+    list_append(&scheduler.ready_queues[priority], &process->ready_node);
+    scheduler.ready_bitmap |= (1u << priority);
+}
 
-    if (child_process->parent_pid != scheduler.current_pid)
-        return -1;
+static void ready_enqueue_front(Process *process)
+{
+    uint8_t priority = get_effective_priority(process);
+    list_prepend(&scheduler.ready_queues[priority], &process->ready_node);
+    scheduler.ready_bitmap |= (1u << priority);
+}
 
-    Process *parent = (Process *)scheduler.processes[scheduler.current_pid]->data;
-    parent->waiting_for_pid = pid;
+static void ready_dequeue(Process *process)
+{
+    uint8_t priority = get_effective_priority(process);
+    List *queue = &scheduler.ready_queues[priority];
 
-    scheduler.foreground_pid = pid;
+    list_remove(queue, &process->ready_node);
 
-    if (child_process->status != ZOMBIE)
-    {
-        set_status(parent->pid, BLOCKED);
-        yield();
-    }
+    if (list_is_empty(queue))
+        scheduler.ready_bitmap &= ~(1u << priority);
+}
 
-    int32_t retval = child_process->return_value;
+static void release_process(Process *process)
+{
+    free_pid(process->pid);
+    scheduler.num_processes--;
 
-    Node *zombie_node = list_get_first(&parent->zombie_children);
-    while (zombie_node != NULL)
+    if (process->cpu != NO_CPU)
     {
-        Process *zombie = (Process *)zombie_node->data;
-        if (zombie->pid == pid)
-        {
-            list_remove(&parent->zombie_children, zombie_node);
-            break;
-        }
-        zombie_node = zombie_node->next;
+        process->release_pending = 1;
+        return;
     }
 
-    scheduler.processes[pid] = NULL;
-    scheduler.num_processes--;
-    free_process(child_process);
-    mm_free(child_process);
-
-    parent->waiting_for_pid = 0;
-    scheduler.foreground_pid = 0;
-
-    return retval;
+    destroy_process(process);
 }
 
-Process *get_current_process()
+static void destroy_process(Process *process)
 {
-    if (scheduler.processes[scheduler.current_pid] == NULL)
-        return NULL;
-    return (Process *)scheduler.processes[scheduler.current_pid]->data;
+    free_process(process);
+    kmem_cache_free(process_cache, process);
 }
 
-Process *get_process_by_pid(uint16_t pid)
+// Pids are handed out round-robin from next_pid, so a freed pid is not reused right away.
+static int32_t alloc_pid(void)
 {
-    if (pid >= MAX_PROCESSES || scheduler.processes[pid] == NULL)
-        return NULL;
-    return (Process *)scheduler.processes[pid]->data;
-}
+    int32_t pid = find_free_pid(scheduler.next_pid);
+    if (pid < 0)
+        pid = find_free_pid(0);
+    if (pid < 0)
+        return -1;
 
-uint16_t get_foreground_process_pid()
-{
-    return scheduler.foreground_pid;
+    uint16_t word = pid / PID_CHUNK_SIZE;
+    if (scheduler.pid_chunks[word] == NULL)
+    {
+        Process **chunk = (Process **)mm_alloc(PID_CHUNK_SIZE * sizeof(Process *));
+        if (chunk == NULL)
+            return -1;
+
+        for (int i = 0; i < PID_CHUNK_SIZE; i++)
+            chunk[i] = NULL;
+        scheduler.pid_chunks[word] = chunk;
+    }
+
+    scheduler.pid_bitmap[word] |= 1ULL << (pid % PID_CHUNK_SIZE);
+    if (scheduler.pid_bitmap[word] == ~0ULL)
+        scheduler.full_pid_words |= 1ULL << word;
+
+    scheduler.next_pid = (pid + 1) % MAX_PIDS;
+    return pid;
 }
 
-static uint16_t get_next_pid()
+// First zero bit at or after from: the summary word skips full words, so this never walks the bitmap.
+static int32_t find_free_pid(uint16_t from)
 {
+    uint16_t word = from / PID_CHUNK_SIZE;
+    uint64_t free_bits = ~scheduler.pid_bitmap[word] & (~0ULL << (from % PID_CHUNK_SIZE));
+    if (free_bits != 0)
+        return word * PID_CHUNK_SIZE + __builtin_ctzll(free_bits);
 
-    for (int i = 0; i < NUM_PRIORITIES; i++)
-    {
-        int lvl = scheduler.current_priority_level;
+    if (word + 1 >= PID_CHUNKS)
+        return -1;
 
-        if (!list_is_empty(&scheduler.ready_queues[lvl]))
-        {
-            Node *node = list_get_first(&scheduler.ready_queues[lvl]);
-            Process *process = (Process *)node->data;
+    uint64_t free_words = ~scheduler.full_pid_words & (~0ULL << (word + 1));
+    if (free_words == 0)
+        return -1;
 
-            scheduler.current_priority_level = (scheduler.current_priority_level - 1 + NUM_PRIORITIES) % NUM_PRIORITIES;
+    word = __builtin_ctzll(free_words);
+    return word * PID_CHUNK_SIZE + __builtin_ctzll(~scheduler.pid_bitmap[word]);
+}
 
-            return process->pid;
-        }
+// Charges the time spent in the status being left to the matching counter.
+static void change_status(Process *process, ProcessStatus new_status)
+{
+    uint64_t now = ticks_elapsed();
+    uint64_t elapsed = now - process->state_since;
 
-        scheduler.current_priority_level = (scheduler.current_priority_level - 1 + NUM_PRIORITIES) % NUM_PRIORITIES;
-    }
+    if (process->status == RUNNING)
+        process->run_ticks += elapsed;
+    else if (process->status == READY)
+        process->ready_ticks += elapsed;
+    else if (process->status == BLOCKED)
+        process->blocked_ticks += elapsed;
+
+    process->state_since = now;
+    process->status = new_status;
+}
+
+static void free_pid(uint16_t pid)
+{
+    uint16_t word = pid / PID_CHUNK_SIZE;
 
-    return IDLE_PID;
+    scheduler.pid_chunks[word][pid % PID_CHUNK_SIZE] = NULL;
+    scheduler.pid_bitmap[word] &= ~(1ULL << (pid % PID_CHUNK_SIZE));
+    scheduler.full_pid_words &= ~(1ULL << word);
 }
@@ -0,0 +1,106 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+
+#include <stdint.h>
+#include <smp.h>
+#include <apic.h>
+#include <spinlock.h>
+#include <time.h>
+#include <interrupts.h>
+
+#define BSP_APIC_ID_PTR ((uint32_t *)0x5A80)
+#define CPUS_DETECTED_PTR ((uint16_t *)0x5B04)
+#define APIC_ID_LIST ((uint8_t *)0x5100)
+#define CPU_ACTIVATED_FLAGS ((uint8_t *)0x5700)
+
+static uint8_t cpu_apic_ids[MAX_CPUS];
+static uint8_t apic_to_cpu[256];
+static uint8_t cpu_count = 1;
+
+static spinlock_t kernel_spinlock = SPINLOCK_INIT;
+
+void smp_init(void)
+{
+    lapic_init();
+
+    for (int i = 0; i < 256; i++)
+    {
+        apic_to_cpu[i] = 0;
+    }
+
+    if (!lapic_is_present())
+    {
+        return;
+    }
+
+    uint8_t bsp_id = (uint8_t)*BSP_APIC_ID_PTR;
+    cpu_apic_ids[0] = bsp_id;
+    apic_to_cpu[bsp_id] = 0;
+
+    uint16_t detected = *CPUS_DETECTED_PTR;
+    for (uint16_t i = 0; i < detected && cpu_count < MAX_CPUS; i++)
+    {
+        uint8_t apic_id = APIC_ID_LIST[i];
+
+        if (apic_id == bsp_id || !CPU_ACTIVATED_FLAGS[apic_id])
+            continue;
+
+        cpu_apic_ids[cpu_count] = apic_id;
+        apic_to_cpu[apic_id] = cpu_count;
+        cpu_count++;
+    }
+
+    if (cpu_count > 1)
+    {
+        lapic_calibrate_timer();
+    }
+}
+
+void smp_start_aps(void)
+{
+    for (uint8_t i = 1; i < cpu_count; i++)
+    {
+        lapic_send_ipi(cpu_apic_ids[i], AP_START_VECTOR);
+    }
+}
+
+void smp_ap_start(void)
+{
+    _syscallInit();
+    lapic_start_timer(TICK_HZ);
+}
+
+uint8_t smp_cpu_count(void)
+{
+    return cpu_count;
+}
+
+uint8_t smp_cpu_index(void)
+{
+    if (cpu_count == 1)
+        return 0;
+    return apic_to_cpu[lapic_get_id()];
+}
+
+uint8_t smp_cpu_of_apic(uint8_t apic_id)
+{
+    return apic_to_cpu[apic_id];
+}
+
+void smp_reschedule(uint8_t cpu)
+{
+    if (cpu >= cpu_count || cpu == smp_cpu_index())
+        return;
+    lapic_send_ipi(cpu_apic_ids[cpu], RESCHEDULE_VECTOR);
+}
+
+void kernel_lock(void)
+{
+    spinlock_acquire(&kernel_spinlock);
+}
+
+void kernel_unlock(void)
+{
+    spinlock_release(&kernel_spinlock);
+}
@@ -0,0 +1,50 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <stddef.h>
+#include <trace.h>
+#include <time.h>
+#include <smp.h>
+#include <lib.h>
+
+// head counts every event ever recorded and tail every event drained; both wrap,
+// and since TRACE_CAPACITY divides 2^32 the slot is always the low bits.
+static TraceEvent ring[TRACE_CAPACITY];
+static volatile uint32_t head;
+static uint32_t tail;
+
+void trace_record(uint8_t type, uint16_t pid, uint8_t arg)
+{
+    // Reserving the slot is a single XADD; once full, the oldest events are overwritten.
+    uint32_t slot = (uint32_t)_xadd((int *)&head, 1);
+    TraceEvent *event = &ring[slot & (TRACE_CAPACITY - 1)];
+
+    event->tick = ticks_elapsed();
+    event->pid = pid;
+    event->type = type;
+    event->cpu = smp_cpu_index();
+    event->arg = arg;
+}
+
+uint32_t trace_drain(TraceEvent *buffer, uint32_t max_count, uint32_t *dropped)
+{
+    uint32_t end = head;
+    uint32_t lost = 0;
+
+    if (end - tail > TRACE_CAPACITY)
+    {
+        lost = end - tail - TRACE_CAPACITY;
+        tail = end - TRACE_CAPACITY;
+    }
+
+    uint32_t count = 0;
+    while (tail != end && count < max_count)
+    {
+        buffer[count++] = ring[tail & (TRACE_CAPACITY - 1)];
+        tail++;
+    }
+
+    if (dropped != NULL)
+        *dropped = lost;
+    return count;
+}
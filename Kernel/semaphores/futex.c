@@ -0,0 +1,98 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <futex.h>
+#include <process.h>
+#include <scheduler.h>
+#include <timer.h>
+#include <time.h>
+#include <list.h>
+#include <stddef.h>
+
+// Waiters hashed by the address they sleep on; each one records its key in futex_key.
+static List buckets[FUTEX_BUCKETS];
+
+static List *bucket_for(int32_t *address);
+static void futex_timeout(void *data);
+
+void futex_init(void)
+{
+    for (int i = 0; i < FUTEX_BUCKETS; i++)
+        list_init(&buckets[i]);
+}
+
+int8_t futex_wait(int32_t *address, int32_t expected, uint64_t timeout_ticks)
+{
+    if (address == NULL || ((uintptr_t)address & 3) != 0)
+        return -1;
+
+    // Checked and queued under the kernel lock, so a wake between the two cannot slip by.
+    if (*(volatile int32_t *)address != expected)
+        return -1;
+
+    if (timeout_ticks == 0)
+        return FUTEX_TIMED_OUT;
+
+    Process *current = get_current_process();
+    List *bucket = bucket_for(address);
+    uint64_t deadline = ticks_elapsed() + timeout_ticks + 1;
+
+    current->futex_key = (uintptr_t)address;
+    process_wait_on(current, bucket);
+
+    if (timeout_ticks != FUTEX_NO_TIMEOUT)
+        timer_arm(&current->sleep_timer, deadline, futex_timeout, current);
+
+    block_process(current->pid, BLOCK_FUTEX);
+    yield();
+
+    timer_cancel(&current->sleep_timer);
+
+    // futex_wake() unlinks the waiters it picks; anything else is a timeout or a spurious wakeup.
+    int8_t timed_out = current->wait_queue == bucket && timeout_ticks != FUTEX_NO_TIMEOUT &&
+                       ticks_elapsed() >= deadline;
+    process_stop_waiting(current);
+    current->futex_key = 0;
+
+    return timed_out ? FUTEX_TIMED_OUT : 0;
+}
+
+int32_t futex_wake(int32_t *address, uint32_t count)
+{
+    if (address == NULL)
+        return -1;
+
+    List *bucket = bucket_for(address);
+    int32_t woken = 0;
+    ListNode *node = list_get_first(bucket);
+
+    while (node != NULL && (uint32_t)woken < count)
+    {
+        ListNode *next = list_next(bucket, node);
+        Process *process = list_entry(node, Process, wait_node);
+
+        if (process->futex_key == (uintptr_t)address)
+        {
+            process_stop_waiting(process);
+            set_status(process->pid, READY);
+            woken++;
+        }
+        node = next;
+    }
+
+    return woken;
+}
+
+static List *bucket_for(int32_t *address)
+{
+    uint64_t key = (uintptr_t)address >> 2;
+    return &buckets[(key * 0x9E3779B97F4A7C15ULL) >> 58];
+}
+
+static void futex_timeout(void *data)
+{
+    Process *process = (Process *)data;
+
+    if (process->status == BLOCKED)
+        set_status(process->pid, READY);
+}
@@ -7,25 +7,43 @@
 #include <process.h>
 #include <scheduler.h>
 #include <semaphores.h>
+#include <slab.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <time.h>
+#include <timer.h>
 
 typedef struct Semaphore
 {
-	uint32_t value;
+	int value;
+	int waiters;
 	int mutex;
-	List *semaphoreQueue;
-	List *mutexQueue;
+	List semaphoreQueue;
+	List mutexQueue;
+	uint8_t inherit;
+	uint8_t topWaiterPriority;
+	uint8_t blockReason;
+	uint8_t destroyed;
+	Process *owner;
+	ListNode ownerNode;
 } Semaphore;
 
 static Semaphore *create_semaphore(uint32_t initialValue);
 static void free_semaphore(Semaphore *sem);
-static int process_is_alive(uint16_t pid);
 static void acquire_mutex(Semaphore *sem);
 static void resume_first_available_process(List *queue);
 static void release_mutex(Semaphore *sem);
 static int up(Semaphore *sem);
-static int down(Semaphore *sem);
+static int down(Semaphore *sem, uint16_t id, uint64_t timeout_ticks);
+static int8_t semaphore_gone(Semaphore *sem, uint16_t id);
+static void leave_destroyed(Semaphore *sem, Process *process);
+static int try_down(Semaphore *sem);
+static void semaphore_timeout(void *data);
+static void take_ownership(Semaphore *sem, Process *process);
+static void disown(Semaphore *sem);
+static void boost(Process *process, uint8_t priority);
+static void update_top_waiter(Semaphore *sem);
+static uint8_t owed_priority(Process *process);
 
 typedef struct SemaphoreManagerCDT
 {
@@ -33,9 +51,12 @@ typedef struct SemaphoreManagerCDT
 } SemaphoreManagerCDT;
 
 static SemaphoreManagerCDT semaphore_manager;
+static KmemCache *semaphore_cache;
 
 void semaphore_manager_init()
 {
+	semaphore_cache = kmem_cache_create("semaphore", sizeof(Semaphore), NULL);
+
 	for (int i = 0; i < MAX_SEMAPHORES; i++)
 		semaphore_manager.semaphores[i] = NULL;
 }
@@ -64,6 +85,24 @@ int8_t sem_init(sem_t *sem, uint32_t initialValue)
 	return 0;
 }
 
+int8_t sem_init_mutex(sem_t *sem)
+{
+	if (sem_init(sem, 1) != 0)
+		return -1;
+
+	get_semaphore_manager()->semaphores[*sem]->inherit = 1;
+	return 0;
+}
+
+int8_t sem_set_block_reason(sem_t *sem, uint8_t reason)
+{
+	if (sem_open(sem) != 0)
+		return -1;
+
+	get_semaphore_manager()->semaphores[*sem]->blockReason = reason;
+	return 0;
+}
+
 int8_t sem_open(sem_t *sem)
 {
 	if (sem == NULL)
@@ -123,6 +162,16 @@ int8_t sem_post(sem_t *sem)
 }
 
 int8_t sem_wait(sem_t *sem)
+{
+	return sem_timedwait(sem, SEM_NO_TIMEOUT);
+}
+
+int8_t sem_trywait(sem_t *sem)
+{
+	return sem_timedwait(sem, 0);
+}
+
+int8_t sem_timedwait(sem_t *sem, uint64_t timeout_ticks)
 {
 	if (sem == NULL)
 		return -1;
@@ -133,150 +182,305 @@ int8_t sem_wait(sem_t *sem)
 	if (id >= MAX_SEMAPHORES || semManager->semaphores[id] == NULL)
 		return -1;
 
-	return down(semManager->semaphores[id]);
+	return down(semManager->semaphores[id], id, timeout_ticks);
 }
 
-static Semaphore *create_semaphore(uint32_t initialValue)
+// A dying process stops counting as a waiter, and every mutex it owns is released as if it had posted it.
+void sem_release_owned(Process *process)
 {
-	Semaphore *sem = (Semaphore *)mm_alloc(sizeof(Semaphore));
-	if (sem == NULL)
+	Semaphore *waited = process->waiting_semaphore;
+	if (waited != NULL && waited->destroyed)
 	{
-		return NULL;
+		leave_destroyed(waited, process);
+	}
+	else if (waited != NULL)
+	{
+		process_stop_waiting(process);
+		process->waiting_semaphore = NULL;
+		_xadd(&waited->waiters, -1);
+
+		// It may have been woken for a unit it will now never take.
+		if (waited->value > 0)
+			resume_first_available_process(&waited->semaphoreQueue);
+		update_top_waiter(waited);
 	}
-	sem->value = initialValue;
-	sem->mutex = 0;
 
-	sem->semaphoreQueue = (List *)mm_alloc(sizeof(List));
-	if (sem->semaphoreQueue == NULL)
+	ListNode *node;
+	while ((node = list_get_first(&process->owned_mutexes)) != NULL)
 	{
-		mm_free(sem);
-		return NULL;
+		Semaphore *sem = list_entry(node, Semaphore, ownerNode);
+		list_remove(&process->owned_mutexes, node);
+		sem->owner = NULL;
+
+		_xadd(&sem->value, 1);
+		resume_first_available_process(&sem->semaphoreQueue);
+		update_top_waiter(sem);
 	}
-	list_init(sem->semaphoreQueue);
+	process->inherited_priority = 0;
+}
 
-	sem->mutexQueue = (List *)mm_alloc(sizeof(List));
-	if (sem->mutexQueue == NULL)
+static Semaphore *create_semaphore(uint32_t initialValue)
+{
+	Semaphore *sem = (Semaphore *)kmem_cache_alloc(semaphore_cache);
+	if (sem == NULL)
 	{
-		mm_free(sem->semaphoreQueue);
-		mm_free(sem);
 		return NULL;
 	}
-	list_init(sem->mutexQueue);
+	sem->value = initialValue > INT32_MAX ? INT32_MAX : (int)initialValue;
+	sem->waiters = 0;
+	sem->mutex = 0;
+	list_init(&sem->semaphoreQueue);
+	list_init(&sem->mutexQueue);
+	sem->inherit = 0;
+	sem->topWaiterPriority = 0;
+	sem->blockReason = BLOCK_SEMAPHORE;
+	sem->destroyed = 0;
+	sem->owner = NULL;
+	list_node_init(&sem->ownerNode);
 
 	return sem;
 }
 
+// Waiters are woken and fail with -1; the memory stays until the last of them has left down().
 static void free_semaphore(Semaphore *sem)
 {
 	if (!sem)
 		return;
 
-	if (sem->semaphoreQueue)
-	{
-		Node *current = sem->semaphoreQueue->head;
-		while (current)
-		{
-			Node *next = current->next;
-			mm_free(current);
-			current = next;
-		}
-		mm_free(sem->semaphoreQueue);
-	}
+	if (sem->owner != NULL)
+		disown(sem);
 
-	if (sem->mutexQueue)
+	sem->destroyed = 1;
+
+	ListNode *node;
+	while ((node = list_get_first(&sem->semaphoreQueue)) != NULL)
 	{
-		Node *current = sem->mutexQueue->head;
-		while (current)
-		{
-			Node *next = current->next;
-			mm_free(current);
-			current = next;
-		}
-		mm_free(sem->mutexQueue);
+		Process *process = list_entry(node, Process, wait_node);
+		timer_cancel(&process->sleep_timer);
+		process_wake_one(&sem->semaphoreQueue);
 	}
+	process_wake_all(&sem->mutexQueue);
 
-	mm_free(sem);
+	if (sem->waiters == 0)
+		kmem_cache_free(semaphore_cache, sem);
 }
 
 static void acquire_mutex(Semaphore *sem)
 {
+	Process *current = get_current_process();
 	while (_xchg(&(sem->mutex), 1))
 	{
-		uint16_t pid = get_pid();
-		Node *node = list_append(sem->mutexQueue, (void *)((uint64_t)pid));
-		if (node == NULL)
-		{
-			continue;
-		}
-		set_status(pid, BLOCKED);
+		process_wait_on(current, &sem->mutexQueue);
+		block_process(current->pid, sem->blockReason);
 		yield();
 	}
-}
-
-static int process_is_alive(uint16_t pid)
-{
-
-	return pid > 0;
+	process_stop_waiting(current);
 }
 
 static void resume_first_available_process(List *queue)
 {
-	Node *current;
-	while ((current = list_get_first(queue)) != NULL)
-	{
+	ListNode *node = list_get_first(queue);
+	if (node == NULL)
+		return;
 
-		void *data = list_remove(queue, current);
-		uint16_t pid = (uint16_t)((uint64_t)data);
-		if (process_is_alive(pid))
-		{
-			set_status(pid, READY);
-			break;
-		}
-	}
+	Process *process = list_entry(node, Process, wait_node);
+	process_stop_waiting(process);
+	set_status(process->pid, READY);
 }
 
 static void release_mutex(Semaphore *sem)
 {
-	resume_first_available_process(sem->mutexQueue);
+	resume_first_available_process(&sem->mutexQueue);
 	sem->mutex = 0;
 }
 
+// Fast path: a CAS on the value. The mutex is taken only when some waiter may need waking.
 static int up(Semaphore *sem)
 {
-	acquire_mutex(sem);
-	sem->value++;
-	if (sem->value == 0)
+	if (sem->inherit)
 	{
-		release_mutex(sem);
-		return -1;
+		if (sem->owner != get_current_process())
+			return -1;
+		disown(sem);
+	}
+
+	int value = sem->value;
+	while (1)
+	{
+		if (value == INT32_MAX)
+			return -1;
+
+		int seen = _cmpxchg(&sem->value, value, value + 1);
+		if (seen == value)
+			break;
+		value = seen;
 	}
-	resume_first_available_process(sem->semaphoreQueue);
+
+	if (sem->waiters == 0)
+		return 0;
+
+	acquire_mutex(sem);
+	resume_first_available_process(&sem->semaphoreQueue);
+	update_top_waiter(sem);
 	release_mutex(sem);
 
 	return 0;
 }
 
-static int down(Semaphore *sem)
+static int down(Semaphore *sem, uint16_t id, uint64_t timeout_ticks)
 {
+	Process *current = get_current_process();
+
+	if (try_down(sem))
+	{
+		if (sem->inherit)
+			take_ownership(sem, current);
+		return 0;
+	}
+
+	if (timeout_ticks == 0)
+		return SEM_TIMED_OUT;
+
+	uint8_t timed = timeout_ticks != SEM_NO_TIMEOUT;
+	uint64_t deadline = ticks_elapsed() + timeout_ticks + 1;
+	int result = 0;
 	acquire_mutex(sem);
-	while (sem->value == 0)
+
+	// Published before re-checking the value, so a concurrent up() either leaves a unit we take or sees us waiting.
+	_xadd(&sem->waiters, 1);
+	current->waiting_semaphore = sem;
+	while (!try_down(sem))
 	{
-		uint16_t pid = get_pid();
-		Node *node = list_append(sem->semaphoreQueue, (void *)((uint64_t)pid));
-		if (node == NULL)
+		if (timed && ticks_elapsed() >= deadline)
 		{
-
-			release_mutex(sem);
-			return -1;
+			result = SEM_TIMED_OUT;
+			break;
 		}
-		set_status(pid, BLOCKED);
+
+		process_wait_on(current, &sem->semaphoreQueue);
+		update_top_waiter(sem);
+		if (timed)
+			timer_arm(&current->sleep_timer, deadline, semaphore_timeout, current);
+		block_process(current->pid, sem->blockReason);
 		release_mutex(sem);
 		yield();
 
+		timer_cancel(&current->sleep_timer);
+		if (semaphore_gone(sem, id))
+		{
+			leave_destroyed(sem, current);
+			return -1;
+		}
 		acquire_mutex(sem);
 	}
-	sem->value--;
+	_xadd(&sem->waiters, -1);
+	current->waiting_semaphore = NULL;
+	process_stop_waiting(current);
+	update_top_waiter(sem);
+	if (sem->inherit && result == 0)
+		take_ownership(sem, current);
 	release_mutex(sem);
 
+	return result;
+}
+
+static int8_t semaphore_gone(Semaphore *sem, uint16_t id)
+{
+	return sem->destroyed || get_semaphore_manager()->semaphores[id] != sem;
+}
+
+// The last waiter out of a destroyed semaphore frees it.
+static void leave_destroyed(Semaphore *sem, Process *process)
+{
+	process_stop_waiting(process);
+	process->waiting_semaphore = NULL;
+	_xadd(&sem->waiters, -1);
+
+	if (sem->waiters == 0)
+		kmem_cache_free(semaphore_cache, sem);
+}
+
+static int try_down(Semaphore *sem)
+{
+	int value = sem->value;
+	while (value > 0)
+	{
+		int seen = _cmpxchg(&sem->value, value, value - 1);
+		if (seen == value)
+			return 1;
+		value = seen;
+	}
 	return 0;
-}
\ No newline at end of file
+}
+
+// The expired waiter leaves semaphoreQueue here, so up() never hands its wakeup to a process that gave up.
+static void semaphore_timeout(void *data)
+{
+	Process *process = (Process *)data;
+	if (process->wait_queue == NULL)
+		return;
+
+	process_stop_waiting(process);
+	set_status(process->pid, READY);
+	if (process->waiting_semaphore != NULL)
+		update_top_waiter(process->waiting_semaphore);
+}
+
+// The new owner inherits the priority of whoever is still queued behind it.
+static void take_ownership(Semaphore *sem, Process *process)
+{
+	sem->owner = process;
+	list_append(&process->owned_mutexes, &sem->ownerNode);
+
+	boost(process, sem->topWaiterPriority);
+}
+
+// Drops the boost this mutex gave, keeping the highest one still owed by the other mutexes it holds.
+static void disown(Semaphore *sem)
+{
+	Process *owner = sem->owner;
+	list_remove(&owner->owned_mutexes, &sem->ownerNode);
+	sem->owner = NULL;
+	set_inherited_priority(owner, owed_priority(owner));
+}
+
+static void boost(Process *process, uint8_t priority)
+{
+	if (process == NULL)
+		return;
+
+	if (priority > process->inherited_priority)
+		set_inherited_priority(process, priority);
+}
+
+// Recomputed from the queue on every join and leave, so a boost never outlives the waiter that caused it.
+static void update_top_waiter(Semaphore *sem)
+{
+	if (!sem->inherit)
+		return;
+
+	uint8_t top = 0;
+	for (ListNode *node = list_get_first(&sem->semaphoreQueue); node != NULL; node = list_next(&sem->semaphoreQueue, node))
+	{
+		uint8_t priority = get_effective_priority(list_entry(node, Process, wait_node));
+		if (priority > top)
+			top = priority;
+	}
+	sem->topWaiterPriority = top;
+
+	if (sem->owner != NULL)
+		set_inherited_priority(sem->owner, owed_priority(sem->owner));
+}
+
+// The highest priority still queued behind any of the mutexes the process holds.
+static uint8_t owed_priority(Process *process)
+{
+	uint8_t inherited = 0;
+	for (ListNode *node = list_get_first(&process->owned_mutexes); node != NULL; node = list_next(&process->owned_mutexes, node))
+	{
+		Semaphore *held = list_entry(node, Semaphore, ownerNode);
+		if (held->topWaiterPriority > inherited)
+			inherited = held->topWaiterPriority;
+	}
+	return inherited;
+}
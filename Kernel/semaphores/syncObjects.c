@@ -0,0 +1,410 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <syncObjects.h>
+#include <semaphores.h>
+#include <scheduler.h>
+#include <process.h>
+#include <slab.h>
+#include <list.h>
+#include <stddef.h>
+
+typedef struct RWLock
+{
+    uint32_t readers;
+    Process *writer;
+    List read_waiters;
+    List write_waiters;
+} RWLock;
+
+typedef struct Condvar
+{
+    uint32_t sequence;
+    List waiters;
+} Condvar;
+
+typedef struct Barrier
+{
+    uint32_t parties;
+    uint32_t arrived;
+    uint32_t generation;
+    List waiters;
+} Barrier;
+
+static RWLock *rwlocks[MAX_RWLOCKS];
+static Condvar *condvars[MAX_CONDVARS];
+static Barrier *barriers[MAX_BARRIERS];
+static KmemCache *rwlock_cache;
+static KmemCache *condvar_cache;
+static KmemCache *barrier_cache;
+
+static RWLock *get_rwlock(uint16_t id);
+static Condvar *get_condvar(uint16_t id);
+static Barrier *get_barrier(uint16_t id);
+static int8_t hand_to_writer(RWLock *lock);
+static void release_write(RWLock *lock);
+static void release_read(RWLock *lock);
+static int8_t find_held(Process *process, int16_t id);
+
+void sync_objects_init(void)
+{
+    rwlock_cache = kmem_cache_create("rwlock", sizeof(RWLock), NULL);
+    condvar_cache = kmem_cache_create("condvar", sizeof(Condvar), NULL);
+    barrier_cache = kmem_cache_create("barrier", sizeof(Barrier), NULL);
+
+    for (int i = 0; i < MAX_RWLOCKS; i++)
+        rwlocks[i] = NULL;
+    for (int i = 0; i < MAX_CONDVARS; i++)
+        condvars[i] = NULL;
+    for (int i = 0; i < MAX_BARRIERS; i++)
+        barriers[i] = NULL;
+}
+
+int8_t rwlock_create(uint16_t id)
+{
+    if (id >= MAX_RWLOCKS || rwlocks[id] != NULL)
+        return -1;
+
+    RWLock *lock = (RWLock *)kmem_cache_alloc(rwlock_cache);
+    if (lock == NULL)
+        return -1;
+
+    lock->readers = 0;
+    lock->writer = NULL;
+    list_init(&lock->read_waiters);
+    list_init(&lock->write_waiters);
+
+    rwlocks[id] = lock;
+    return 0;
+}
+
+int8_t rwlock_destroy(uint16_t id)
+{
+    RWLock *lock = get_rwlock(id);
+    if (lock == NULL || lock->writer != NULL || lock->readers > 0)
+        return -1;
+
+    rwlocks[id] = NULL;
+    process_wake_all(&lock->read_waiters);
+    process_wake_all(&lock->write_waiters);
+
+    kmem_cache_free(rwlock_cache, lock);
+    return 0;
+}
+
+int8_t rwlock_lock(uint16_t id, uint8_t mode)
+{
+    RWLock *lock = get_rwlock(id);
+    if (lock == NULL || mode > RWLOCK_WRITE)
+        return -1;
+
+    Process *current = get_current_process();
+
+    if (mode == RWLOCK_READ)
+    {
+        // Read holds are recorded on the process, so sync_release can give them back if it dies.
+        int8_t slot = find_held(current, -1);
+        if (slot < 0)
+            return -1;
+
+        // Writer-preferring: once a writer queues, new readers wait behind it.
+        while (lock->writer != NULL || !list_is_empty(&lock->write_waiters))
+        {
+            process_block_on(&lock->read_waiters, BLOCK_SYNC);
+
+            if (lock != get_rwlock(id))
+                return -1;
+        }
+
+        lock->readers++;
+        current->rwlock_ids[slot] = (int16_t)id;
+        return 0;
+    }
+
+    if (lock->writer == current)
+        return -1;
+
+    if (lock->writer == NULL && lock->readers == 0)
+    {
+        lock->writer = current;
+        return 0;
+    }
+
+    // Ownership is handed over on unlock, so a woken writer never races readers for the lock.
+    while (lock->writer != current)
+    {
+        process_block_on(&lock->write_waiters, BLOCK_SYNC);
+
+        if (lock != get_rwlock(id))
+            return -1;
+    }
+
+    return 0;
+}
+
+int8_t rwlock_unlock(uint16_t id)
+{
+    RWLock *lock = get_rwlock(id);
+    Process *current = get_current_process();
+    if (lock == NULL)
+        return -1;
+
+    if (lock->writer == current)
+    {
+        release_write(lock);
+        return 0;
+    }
+
+    int8_t slot = find_held(current, (int16_t)id);
+    if (slot < 0)
+        return -1;
+
+    current->rwlock_ids[slot] = -1;
+    release_read(lock);
+    return 0;
+}
+
+int8_t cond_create(uint16_t id)
+{
+    if (id >= MAX_CONDVARS || condvars[id] != NULL)
+        return -1;
+
+    Condvar *cond = (Condvar *)kmem_cache_alloc(condvar_cache);
+    if (cond == NULL)
+        return -1;
+
+    cond->sequence = 0;
+    list_init(&cond->waiters);
+
+    condvars[id] = cond;
+    return 0;
+}
+
+int8_t cond_destroy(uint16_t id)
+{
+    Condvar *cond = get_condvar(id);
+    if (cond == NULL)
+        return -1;
+
+    condvars[id] = NULL;
+    process_wake_all(&cond->waiters);
+
+    kmem_cache_free(condvar_cache, cond);
+    return 0;
+}
+
+int8_t cond_wait(uint16_t id, uint16_t sem_id)
+{
+    Condvar *cond = get_condvar(id);
+    sem_t mutex = sem_id;
+    if (cond == NULL)
+        return -1;
+
+    // Any signal after this point bumps the sequence, even if releasing the mutex reschedules us.
+    uint32_t sequence = cond->sequence;
+    if (sem_post(&mutex) != 0)
+        return -1;
+
+    if (cond == get_condvar(id) && cond->sequence == sequence)
+        process_block_on(&cond->waiters, BLOCK_SYNC);
+
+    int8_t destroyed = cond != get_condvar(id);
+
+    // The caller gets the mutex back either way, as it expects after a wait.
+    if (sem_wait(&mutex) != 0 || destroyed)
+        return -1;
+
+    return 0;
+}
+
+int8_t cond_signal(uint16_t id)
+{
+    Condvar *cond = get_condvar(id);
+    if (cond == NULL)
+        return -1;
+
+    cond->sequence++;
+    process_wake_one(&cond->waiters);
+    return 0;
+}
+
+int8_t cond_broadcast(uint16_t id)
+{
+    Condvar *cond = get_condvar(id);
+    if (cond == NULL)
+        return -1;
+
+    cond->sequence++;
+    process_wake_all(&cond->waiters);
+    return 0;
+}
+
+int8_t barrier_create(uint16_t id, uint32_t parties)
+{
+    if (id >= MAX_BARRIERS || barriers[id] != NULL || parties == 0)
+        return -1;
+
+    Barrier *barrier = (Barrier *)kmem_cache_alloc(barrier_cache);
+    if (barrier == NULL)
+        return -1;
+
+    barrier->parties = parties;
+    barrier->arrived = 0;
+    barrier->generation = 0;
+    list_init(&barrier->waiters);
+
+    barriers[id] = barrier;
+    return 0;
+}
+
+int8_t barrier_destroy(uint16_t id)
+{
+    Barrier *barrier = get_barrier(id);
+    if (barrier == NULL)
+        return -1;
+
+    barriers[id] = NULL;
+    process_wake_all(&barrier->waiters);
+
+    kmem_cache_free(barrier_cache, barrier);
+    return 0;
+}
+
+int8_t barrier_wait(uint16_t id)
+{
+    Barrier *barrier = get_barrier(id);
+    if (barrier == NULL)
+        return -1;
+
+    uint32_t generation = barrier->generation;
+
+    // The last party to arrive releases the rest and starts the next round.
+    if (++barrier->arrived == barrier->parties)
+    {
+        barrier->arrived = 0;
+        barrier->generation++;
+        process_wake_all(&barrier->waiters);
+        return BARRIER_SERIAL;
+    }
+
+    while (barrier->generation == generation)
+    {
+        process_block_on(&barrier->waiters, BLOCK_SYNC);
+
+        if (barrier != get_barrier(id))
+            return -1;
+    }
+
+    return 0;
+}
+
+static RWLock *get_rwlock(uint16_t id)
+{
+    if (id >= MAX_RWLOCKS)
+        return NULL;
+    return rwlocks[id];
+}
+
+static Condvar *get_condvar(uint16_t id)
+{
+    if (id >= MAX_CONDVARS)
+        return NULL;
+    return condvars[id];
+}
+
+static Barrier *get_barrier(uint16_t id)
+{
+    if (id >= MAX_BARRIERS)
+        return NULL;
+    return barriers[id];
+}
+
+// Run before the dying process leaves its wait queue, so the queue it sat on can still be told apart.
+void sync_release(Process *process)
+{
+    for (int i = 0; i < MAX_PROCESS_RWLOCKS; i++)
+    {
+        if (process->rwlock_ids[i] == -1)
+            continue;
+
+        RWLock *lock = get_rwlock((uint16_t)process->rwlock_ids[i]);
+        process->rwlock_ids[i] = -1;
+        if (lock != NULL)
+            release_read(lock);
+    }
+
+    // The writer is found on the lock itself: a handed-over lock is held before its new owner even runs.
+    for (int i = 0; i < MAX_RWLOCKS; i++)
+    {
+        RWLock *lock = rwlocks[i];
+        if (lock == NULL)
+            continue;
+
+        if (lock->writer == process)
+            release_write(lock);
+
+        if (process->wait_queue == &lock->write_waiters)
+        {
+            // Readers held back only by this writer would otherwise wait for nobody.
+            process_stop_waiting(process);
+            if (lock->writer == NULL && list_is_empty(&lock->write_waiters))
+                process_wake_all(&lock->read_waiters);
+        }
+    }
+
+    if (process->wait_queue == NULL)
+        return;
+
+    for (int i = 0; i < MAX_BARRIERS; i++)
+    {
+        Barrier *barrier = barriers[i];
+        if (barrier != NULL && process->wait_queue == &barrier->waiters)
+        {
+            process_stop_waiting(process);
+            barrier->arrived--;
+            return;
+        }
+    }
+}
+
+static void release_write(RWLock *lock)
+{
+    lock->writer = NULL;
+
+    // With no writer queued, every waiting reader is let in at once.
+    if (!hand_to_writer(lock))
+        process_wake_all(&lock->read_waiters);
+}
+
+static void release_read(RWLock *lock)
+{
+    if (lock->readers == 0)
+        return;
+
+    lock->readers--;
+    if (lock->readers == 0)
+        hand_to_writer(lock);
+}
+
+static int8_t find_held(Process *process, int16_t id)
+{
+    for (int8_t i = 0; i < MAX_PROCESS_RWLOCKS; i++)
+    {
+        if (process->rwlock_ids[i] == id)
+            return i;
+    }
+    return -1;
+}
+
+static int8_t hand_to_writer(RWLock *lock)
+{
+    ListNode *node = list_get_first(&lock->write_waiters);
+    if (node == NULL)
+        return 0;
+
+    Process *writer = list_entry(node, Process, wait_node);
+    lock->writer = writer;
+    process_stop_waiting(writer);
+    set_status(writer->pid, READY);
+    return 1;
+}
@@ -14,6 +14,8 @@ typedef signed long int64_t; //-V677
 
 typedef unsigned int size_t; //-V677
 
+#define INT32_MAX 2147483647
+
 extern uintptr_t __stack_chk_guard;
 void __attribute__((noreturn)) __stack_chk_fail(void);
 
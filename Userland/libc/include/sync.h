@@ -0,0 +1,44 @@
+#ifndef _SYNC_H
+#define _SYNC_H
+
+#include <stdint.h>
+
+// Futex-backed primitives: the uncontended paths never leave userland.
+
+typedef struct
+{
+    int32_t state;
+} mutex_t;
+
+typedef struct
+{
+    int32_t sequence;
+} cond_t;
+
+typedef struct
+{
+    int32_t value;
+    int32_t waiters;
+} semaphore_t;
+
+int32_t atomic_cmpxchg(int32_t *ptr, int32_t expected, int32_t desired);
+int32_t atomic_xchg(int32_t *ptr, int32_t value);
+int32_t atomic_add(int32_t *ptr, int32_t value);
+void cpu_relax(void);
+
+void mutex_init(mutex_t *mutex);
+void mutex_lock(mutex_t *mutex);
+int mutex_trylock(mutex_t *mutex);
+void mutex_unlock(mutex_t *mutex);
+
+void cond_init(cond_t *cond);
+void cond_wait(cond_t *cond, mutex_t *mutex);
+void cond_signal(cond_t *cond);
+void cond_broadcast(cond_t *cond);
+
+void semaphore_init(semaphore_t *sem, int32_t value);
+void semaphore_wait(semaphore_t *sem);
+int semaphore_trywait(semaphore_t *sem);
+void semaphore_post(semaphore_t *sem);
+
+#endif
@@ -3,7 +3,26 @@
 
 #include <stdint.h>
 
-#define DEV_NULL 3
+#define DEV_NULL -1
+
+#define PIPE_READ 0
+#define PIPE_WRITE 1
+#define O_NONBLOCK 0x01
+#define WOULD_BLOCK -2
+
+#define POLLIN 0x01
+#define POLLOUT 0x02
+#define POLLHUP 0x04
+#define POLLNVAL 0x08
+#define MAX_POLL_FDS 8
+#define POLL_NO_TIMEOUT ((uint64_t)-1)
+
+typedef struct
+{
+    int16_t fd;
+    uint8_t events;
+    uint8_t revents;
+} PollFd;
 
 typedef enum
 {
@@ -23,8 +42,86 @@ typedef struct
     void *stack_base;
     void *stack_pos;
     uint8_t is_foreground;
+    uint8_t last_cpu;
+    uint64_t run_ticks;
+    uint64_t ready_ticks;
+    uint64_t blocked_ticks;
+    uint64_t voluntary_switches;
+    uint64_t involuntary_switches;
 } ProcessInfo;
 
+#define NO_CPU 0xFF
+
+#define TRACE_CAPACITY 1024
+
+typedef enum
+{
+    TRACE_SWITCH_IN = 0,
+    TRACE_SWITCH_OUT,
+    TRACE_BLOCK,
+    TRACE_UNBLOCK,
+    TRACE_AGING,
+    TRACE_KILL
+} TraceEventType;
+
+typedef enum
+{
+    BLOCK_OTHER = 0,
+    BLOCK_PIPE,
+    BLOCK_SEMAPHORE,
+    BLOCK_WAITPID,
+    BLOCK_KEYBOARD,
+    BLOCK_SLEEP,
+    BLOCK_POLL,
+    BLOCK_FUTEX,
+    BLOCK_MESSAGE_QUEUE,
+    BLOCK_SYNC,
+    BLOCK_MANUAL
+} BlockReason;
+
+typedef struct
+{
+    uint64_t tick;
+    uint16_t pid;
+    uint8_t type;
+    uint8_t cpu;
+    uint8_t arg;
+} TraceEvent;
+
+typedef struct
+{
+    char name[32];
+    uint32_t object_size;
+    uint32_t objects_in_use;
+    uint32_t objects_total;
+    uint32_t slabs;
+} KmemCacheInfo;
+
+#define KERNEL_INFO_ADDRESS 0x90000
+#define MAX_CPUS 8
+
+typedef struct
+{
+    volatile uint64_t switch_count;
+    volatile uint16_t pid;
+} KernelInfoCpu;
+
+typedef struct
+{
+    uint32_t version;
+    uint32_t tick_hz;
+    volatile uint64_t ticks;
+    uint64_t hpet_address;
+    uint64_t hpet_period_fs;
+    uint64_t hpet_boot_ns;
+    uint64_t lapic_address;
+    uint8_t cpu_count;
+    uint8_t apic_to_cpu[256];
+    KernelInfoCpu cpus[MAX_CPUS];
+    volatile uint64_t memory_total;
+    volatile uint64_t memory_free;
+} KernelInfoPage;
+
 uint64_t sys_read(uint64_t fd, char *buf, uint64_t count);
 uint64_t sys_write(uint64_t fd, const char *buf, uint64_t count);
 void sys_clear_text_buffer(void);
@@ -32,6 +129,7 @@ void sys_clear_text_buffer(void);
 uint64_t sys_create_process(uint64_t code_ptr, uint64_t args_ptr, uint64_t name_ptr, uint64_t priority, uint64_t fds_ptr);
 uint64_t sys_kill_process(uint64_t pid, uint64_t retval);
 uint64_t sys_get_pid(void);
+uint64_t sys_get_pid_int80(void);
 uint64_t sys_yield(void);
 uint64_t sys_set_priority(uint64_t pid, uint64_t new_priority);
 uint64_t sys_block(uint64_t pid);
@@ -45,19 +143,72 @@ int64_t sys_sem_destroy(uint64_t sem_id);
 int64_t sys_sem_wait(uint64_t sem_id);
 int64_t sys_sem_post(uint64_t sem_id);
 
+#define SEM_TIMED_OUT -2
+
+int64_t sys_sem_trywait(uint64_t sem_id);
+int64_t sys_sem_timedwait(uint64_t sem_id, uint64_t timeout_ticks);
+int64_t sys_sem_init_mutex(uint64_t sem_id);
+
 int64_t sys_pipe_open(uint16_t id, uint8_t mode);
-int64_t sys_pipe_close(uint16_t id);
+int64_t sys_pipe_close(uint16_t id, uint8_t mode);
 int16_t sys_pipe_get(void);
+int16_t sys_pipe_create(uint64_t capacity);
+int64_t sys_set_fd_flags(uint64_t fd, uint64_t flags);
+int64_t sys_poll(PollFd *fds, uint64_t count, uint64_t timeout_ticks);
+int64_t sys_splice(uint64_t fd_in, uint64_t fd_out, uint64_t len);
+int64_t sys_tee(uint64_t fd_in, uint64_t fd_out, uint64_t len);
+
+int64_t sys_shm_create(uint64_t id, uint64_t size);
+void *sys_shm_attach(uint64_t id);
+int64_t sys_shm_detach(uint64_t id);
+int64_t sys_shm_destroy(uint64_t id);
+
+#define MQ_PRIORITIES 8
+
+int64_t sys_mq_create(uint64_t id, uint64_t max_messages, uint64_t message_size);
+int64_t sys_mq_destroy(uint64_t id);
+int64_t sys_mq_send(uint64_t id, const void *message, uint64_t length, uint64_t priority);
+int64_t sys_mq_receive(uint64_t id, void *buffer, uint64_t length, uint8_t *priority);
+
+#define FUTEX_NO_TIMEOUT ((uint64_t)-1)
+#define FUTEX_TIMED_OUT -2
+
+int64_t sys_futex_wait(int32_t *address, int32_t expected, uint64_t timeout_ticks);
+int64_t sys_futex_wake(int32_t *address, uint64_t count);
+
+#define RWLOCK_READ 0
+#define RWLOCK_WRITE 1
+#define BARRIER_SERIAL 1
+
+int64_t sys_rwlock_create(uint64_t id);
+int64_t sys_rwlock_destroy(uint64_t id);
+int64_t sys_rwlock_lock(uint64_t id, uint64_t mode);
+int64_t sys_rwlock_unlock(uint64_t id);
+
+int64_t sys_cond_create(uint64_t id);
+int64_t sys_cond_destroy(uint64_t id);
+int64_t sys_cond_wait(uint64_t id, uint64_t sem_id);
+int64_t sys_cond_signal(uint64_t id);
+int64_t sys_cond_broadcast(uint64_t id);
+
+int64_t sys_barrier_create(uint64_t id, uint64_t parties);
+int64_t sys_barrier_destroy(uint64_t id);
+int64_t sys_barrier_wait(uint64_t id);
 
 int64_t sys_get_process_info(ProcessInfo *info_array, uint64_t max_count);
+int64_t sys_trace_drain(TraceEvent *buffer, uint64_t max_count, uint32_t *dropped);
 
 uint64_t sys_malloc(uint64_t size);
 uint64_t sys_free(uint64_t ptr);
 
 uint64_t sys_mem_state(uint64_t total_ptr, uint64_t free_ptr, uint64_t used_ptr, uint64_t name_ptr);
+int64_t sys_get_kmem_info(KmemCacheInfo *info_array, uint64_t max_count);
 
 uint64_t sys_sleep(uint64_t seconds);
+uint64_t sys_sleep_ms(uint64_t milliseconds);
+uint64_t sys_nanosleep(uint64_t nanoseconds);
 uint64_t sys_get_ticks(void);
+uint64_t sys_get_time_ns(void);
 
 static inline void sleep(int seconds)
 {
@@ -70,5 +221,12 @@ int64_t create_process_with_fds(void *code, char **args, char *name,
 int64_t waitpid(uint16_t pid);
 
 int16_t pipe_get(void);
+int16_t pipe_create(uint32_t capacity);
+
+// Read straight from the kernel info page, without trapping.
+const KernelInfoPage *kernel_info(void);
+uint16_t getpid(void);
+uint64_t get_ticks(void);
+uint64_t get_time_ns(void);
 
 #endif
\ No newline at end of file
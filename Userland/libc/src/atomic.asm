@@ -0,0 +1,30 @@
+GLOBAL atomic_cmpxchg
+GLOBAL atomic_xchg
+GLOBAL atomic_add
+GLOBAL cpu_relax
+
+section .text
+
+; Returns the value found in [rdi]; the swap happened iff it equals esi.
+atomic_cmpxchg:
+    mov eax, esi
+    lock cmpxchg [rdi], edx
+    ret
+
+atomic_xchg:
+    mov eax, esi
+    xchg [rdi], eax
+    ret
+
+; Returns the value [rdi] held before adding esi.
+atomic_add:
+    mov eax, esi
+    lock xadd [rdi], eax
+    ret
+
+cpu_relax:
+    pause
+    ret
+
+
+section .note.GNU-stack noalloc noexec nowrite progbits
@@ -0,0 +1,55 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+
+#include "../include/unistd.h"
+
+#define LAPIC_ID_REGISTER 0x20
+#define HPET_MAIN_COUNTER 0xF0
+#define FEMTOSECONDS_PER_NANOSECOND 1000000
+
+static const KernelInfoPage *info = (const KernelInfoPage *)KERNEL_INFO_ADDRESS;
+
+static uint8_t current_cpu(void)
+{
+    if (info->cpu_count <= 1)
+        return 0;
+
+    uint32_t id = *(volatile uint32_t *)(info->lapic_address + LAPIC_ID_REGISTER);
+    return info->apic_to_cpu[id >> 24];
+}
+
+const KernelInfoPage *kernel_info(void)
+{
+    return info;
+}
+
+uint16_t getpid(void)
+{
+    while (1)
+    {
+        uint8_t cpu = current_cpu();
+        uint64_t switches = info->cpus[cpu].switch_count;
+        uint16_t pid = info->cpus[cpu].pid;
+
+        // Still on the same CPU with no switch in between: pid is ours.
+        if (current_cpu() == cpu && info->cpus[cpu].switch_count == switches)
+            return pid;
+    }
+}
+
+uint64_t get_ticks(void)
+{
+    return info->ticks;
+}
+
+uint64_t get_time_ns(void)
+{
+    if (info->hpet_address == 0)
+        return info->ticks * (1000000000ULL / info->tick_hz);
+
+    uint64_t counter = *(volatile uint64_t *)(info->hpet_address + HPET_MAIN_COUNTER);
+    uint64_t whole = (counter / FEMTOSECONDS_PER_NANOSECOND) * info->hpet_period_fs;
+    uint64_t rest = (counter % FEMTOSECONDS_PER_NANOSECOND) * info->hpet_period_fs / FEMTOSECONDS_PER_NANOSECOND;
+    return whole + rest - info->hpet_boot_ns;
+}
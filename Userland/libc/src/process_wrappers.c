@@ -21,4 +21,9 @@ int64_t waitpid(uint16_t pid)
 int16_t pipe_get(void)
 {
     return (int16_t)sys_pipe_get();
+}
+
+int16_t pipe_create(uint32_t capacity)
+{
+    return (int16_t)sys_pipe_create((uint64_t)capacity);
 }
\ No newline at end of file
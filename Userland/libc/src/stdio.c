@@ -15,7 +15,10 @@ int scanf(const char *format, void** args){
      
     uint32_t len = 0;
     while (len < SCANF_BUFF_MAX_SIZE - 1) {
-        char c = getchar();   
+        int c = getchar();   
+        if (c == EOF) {
+            break;
+        }
         if (c == '\n' || c == '\r') {
             putchar(c);
             break;
@@ -132,8 +135,10 @@ int puts(const char *s){
 }
 
 int getchar(void){
-    char c;
-    sys_read((uint64_t)STDIN, &c, 1);
+    unsigned char c;
+    if ((int64_t)sys_read((uint64_t)STDIN, (char *)&c, 1) <= 0) {
+        return EOF;
+    }
     return c;
 }
 
@@ -152,7 +157,7 @@ char *fgets(char *s, int size, int stream) {
     
      
     while (i < size - 1) {
-        if (sys_read((uint64_t)STDIN, &c, 1) <= 0) {
+        if ((int64_t)sys_read((uint64_t)STDIN, &c, 1) <= 0) {
              
             if (i == 0) {
                 return NULL;   
@@ -74,8 +74,8 @@ char *itoa(int num, char *dest)
 
 int rand(void)
 {
-    uint64_t pid = sys_get_pid();
-    uint64_t ticks = sys_get_ticks();
+    uint64_t pid = getpid();
+    uint64_t ticks = get_ticks();
     uint32_t rand_state = (uint32_t)((pid * 1103515245) + ticks);
 
     rand_state = rand_state * 1103515245 + 12345;
@@ -0,0 +1,123 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+
+#include "../include/sync.h"
+#include "../include/unistd.h"
+
+#define SPIN_LIMIT 100
+
+// Mutex states: 0 unlocked, 1 locked, 2 locked with (possible) sleepers.
+#define UNLOCKED 0
+#define LOCKED 1
+#define CONTENDED 2
+
+void mutex_init(mutex_t *mutex)
+{
+    mutex->state = UNLOCKED;
+}
+
+int mutex_trylock(mutex_t *mutex)
+{
+    return atomic_cmpxchg(&mutex->state, UNLOCKED, LOCKED) == UNLOCKED;
+}
+
+void mutex_lock(mutex_t *mutex)
+{
+    int32_t state = atomic_cmpxchg(&mutex->state, UNLOCKED, LOCKED);
+    if (state == UNLOCKED)
+        return;
+
+    for (int i = 0; i < SPIN_LIMIT; i++)
+    {
+        cpu_relax();
+        if (*(volatile int32_t *)&mutex->state == UNLOCKED &&
+            (state = atomic_cmpxchg(&mutex->state, UNLOCKED, LOCKED)) == UNLOCKED)
+            return;
+    }
+
+    if (state != CONTENDED)
+        state = atomic_xchg(&mutex->state, CONTENDED);
+
+    while (state != UNLOCKED)
+    {
+        sys_futex_wait(&mutex->state, CONTENDED, FUTEX_NO_TIMEOUT);
+        state = atomic_xchg(&mutex->state, CONTENDED);
+    }
+}
+
+void mutex_unlock(mutex_t *mutex)
+{
+    if (atomic_add(&mutex->state, -1) != LOCKED)
+    {
+        mutex->state = UNLOCKED;
+        sys_futex_wake(&mutex->state, 1);
+    }
+}
+
+void cond_init(cond_t *cond)
+{
+    cond->sequence = 0;
+}
+
+void cond_wait(cond_t *cond, mutex_t *mutex)
+{
+    int32_t sequence = *(volatile int32_t *)&cond->sequence;
+
+    mutex_unlock(mutex);
+    sys_futex_wait(&cond->sequence, sequence, FUTEX_NO_TIMEOUT);
+    mutex_lock(mutex);
+}
+
+void cond_signal(cond_t *cond)
+{
+    atomic_add(&cond->sequence, 1);
+    sys_futex_wake(&cond->sequence, 1);
+}
+
+void cond_broadcast(cond_t *cond)
+{
+    atomic_add(&cond->sequence, 1);
+    sys_futex_wake(&cond->sequence, INT32_MAX);
+}
+
+void semaphore_init(semaphore_t *sem, int32_t value)
+{
+    sem->value = value;
+    sem->waiters = 0;
+}
+
+int semaphore_trywait(semaphore_t *sem)
+{
+    int32_t value = *(volatile int32_t *)&sem->value;
+    while (value > 0)
+    {
+        int32_t seen = atomic_cmpxchg(&sem->value, value, value - 1);
+        if (seen == value)
+            return 1;
+        value = seen;
+    }
+    return 0;
+}
+
+void semaphore_wait(semaphore_t *sem)
+{
+    for (int i = 0; i < SPIN_LIMIT; i++)
+    {
+        if (semaphore_trywait(sem))
+            return;
+        cpu_relax();
+    }
+
+    atomic_add(&sem->waiters, 1);
+    while (!semaphore_trywait(sem))
+        sys_futex_wait(&sem->value, 0, FUTEX_NO_TIMEOUT);
+    atomic_add(&sem->waiters, -1);
+}
+
+void semaphore_post(semaphore_t *sem)
+{
+    atomic_add(&sem->value, 1);
+    if (*(volatile int32_t *)&sem->waiters > 0)
+        sys_futex_wake(&sem->value, 1);
+}
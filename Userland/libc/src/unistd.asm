@@ -20,17 +20,69 @@ GLOBAL sys_waitpid
 GLOBAL sys_pipe_open
 GLOBAL sys_pipe_close
 GLOBAL sys_pipe_get
+GLOBAL sys_pipe_create
+GLOBAL sys_poll
+GLOBAL sys_set_fd_flags
+GLOBAL sys_splice
+GLOBAL sys_tee
+GLOBAL sys_shm_create
+GLOBAL sys_shm_attach
+GLOBAL sys_shm_detach
+GLOBAL sys_shm_destroy
+GLOBAL sys_mq_create
+GLOBAL sys_mq_destroy
+GLOBAL sys_mq_send
+GLOBAL sys_mq_receive
+GLOBAL sys_futex_wait
+GLOBAL sys_futex_wake
+GLOBAL sys_sem_trywait
+GLOBAL sys_sem_timedwait
+GLOBAL sys_sem_init_mutex
+GLOBAL sys_rwlock_create
+GLOBAL sys_rwlock_destroy
+GLOBAL sys_rwlock_lock
+GLOBAL sys_rwlock_unlock
+GLOBAL sys_cond_create
+GLOBAL sys_cond_destroy
+GLOBAL sys_cond_wait
+GLOBAL sys_cond_signal
+GLOBAL sys_cond_broadcast
+GLOBAL sys_barrier_create
+GLOBAL sys_barrier_destroy
+GLOBAL sys_barrier_wait
 GLOBAL sys_get_process_info
+GLOBAL sys_trace_drain
 GLOBAL sys_sleep
 GLOBAL sys_mem_state
 GLOBAL sys_get_ticks
+GLOBAL sys_get_kmem_info
+GLOBAL sys_get_time_ns
+GLOBAL sys_sleep_ms
+GLOBAL sys_nanosleep
+GLOBAL sys_get_pid_int80
 
 section .text
 
+; Fast path. The SYSCALL mnemonic is shadowed by this macro's name, so it
+; is emitted as raw opcode bytes.
 %macro syscall 1
     push rbp
     mov rbp, rsp
 
+    mov rax, %1
+    mov r10, rcx
+    db 0x0F, 0x05
+
+    mov rsp, rbp
+    pop rbp
+    ret
+%endmacro
+
+; Legacy trap gate, kept for compatibility and benchmarking.
+%macro syscall_int80 1
+    push rbp
+    mov rbp, rsp
+
     mov rax, %1
     mov r10, rcx
     int 0x80
@@ -134,15 +186,123 @@ sys_pipe_close:
 sys_pipe_get:
     syscall 21
 
+sys_pipe_create:
+    syscall 30
+
+sys_poll:
+    syscall 31
+
+sys_set_fd_flags:
+    syscall 32
+
+sys_splice:
+    syscall 33
+
+sys_tee:
+    syscall 34
+
+sys_shm_create:
+    syscall 35
+
+sys_shm_attach:
+    syscall 36
+
+sys_shm_detach:
+    syscall 37
+
+sys_shm_destroy:
+    syscall 60
+
+sys_mq_create:
+    syscall 38
+
+sys_mq_destroy:
+    syscall 39
+
+sys_mq_send:
+    syscall 40
+
+sys_mq_receive:
+    syscall 41
+
+sys_futex_wait:
+    syscall 42
+
+sys_futex_wake:
+    syscall 43
+
+sys_sem_trywait:
+    syscall 44
+
+sys_sem_timedwait:
+    syscall 45
+
+sys_sem_init_mutex:
+    syscall 46
+
+sys_rwlock_create:
+    syscall 47
+
+sys_rwlock_destroy:
+    syscall 48
+
+sys_rwlock_lock:
+    syscall 49
+
+sys_rwlock_unlock:
+    syscall 50
+
+sys_cond_create:
+    syscall 51
+
+sys_cond_destroy:
+    syscall 52
+
+sys_cond_wait:
+    syscall 53
+
+sys_cond_signal:
+    syscall 54
+
+sys_cond_broadcast:
+    syscall 55
+
+sys_barrier_create:
+    syscall 56
+
+sys_barrier_destroy:
+    syscall 57
+
+sys_barrier_wait:
+    syscall 58
+
 sys_get_process_info:
     syscall 22
 
+sys_trace_drain:
+    syscall 59
+
 sys_sleep:
     syscall 23
 
 sys_get_ticks:
     syscall 25
 
+sys_get_kmem_info:
+    syscall 26
+
+sys_get_time_ns:
+    syscall 27
+
+sys_sleep_ms:
+    syscall 28
+
+sys_nanosleep:
+    syscall 29
+
+sys_get_pid_int80:
+    syscall_int80 4
+
 
 section .note.GNU-stack noalloc noexec nowrite progbits
 
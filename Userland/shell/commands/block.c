@@ -4,12 +4,11 @@
  
  
 #include <stdio.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include "../commands/commands.h"
 
-#define MAX_PROCESSES 20
-
 int block_main(int argc, char **argv) {
     void *args[2] = {(void*)(uint64_t)0, (void*)(uint64_t)0};
 
@@ -28,11 +27,18 @@ int block_main(int argc, char **argv) {
     }
 
      
-    ProcessInfo info[MAX_PROCESSES];
-    int count = sys_get_process_info(info, MAX_PROCESSES);
+    int capacity = (int)sys_get_process_info(NULL, 0) + 8;
+    ProcessInfo *info = (ProcessInfo *)malloc(capacity * sizeof(ProcessInfo));
+    if (info == NULL) {
+        printf("Not enough memory\n", args);
+        return 1;
+    }
+
+    int count = sys_get_process_info(info, capacity);
 
     if (count < 0) {
         printf("Failed to get process information\n", args);
+        free(info);
         return 1;
     }
 
@@ -46,6 +52,7 @@ int block_main(int argc, char **argv) {
             break;
         }
     }
+    free(info);
 
     if (!found) {
         args[0] = (void*)&pid;
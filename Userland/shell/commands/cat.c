@@ -4,14 +4,27 @@
  
 #include "stdio.h"
 #include "stddef.h"
+#include "unistd.h"
 #include "commands.h"
 
+#define CAT_CHUNK_SIZE 512
+#define CAT_SPLICE_SIZE 4096
+
 static int cat_func(int argc, char **argv) {
-    int c;
+    char chunk[CAT_CHUNK_SIZE];
+    int64_t n = sys_splice(STDIN, STDOUT, CAT_SPLICE_SIZE);
+
+     
+    if (n >= 0) {
+        while (n > 0) {
+            n = sys_splice(STDIN, STDOUT, CAT_SPLICE_SIZE);
+        }
+        return 0;
+    }
 
      
-    while ((c = getchar()) != EOF) {
-        putchar(c);
+    while ((n = (int64_t)sys_read(STDIN, chunk, CAT_CHUNK_SIZE)) > 0) {
+        sys_write(STDOUT, chunk, (uint64_t)n);
     }
 
     return 0;
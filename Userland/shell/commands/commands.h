@@ -20,6 +20,8 @@ extern command clear_cmd;
 extern command help_cmd;
 extern command test_synchro_cmd;
 extern command test_no_synchro_cmd;
+extern command test_sem_destroy_cmd;
+extern command test_rwlock_cmd;
 extern command test_processes_cmd;
 extern command ps_cmd;
 extern command loop_cmd;
@@ -31,6 +33,12 @@ extern command cat_cmd;
 extern command mem_cmd;
 extern command filter_cmd;
 extern command mvar_cmd;
+extern command sysbench_cmd;
+extern command pipebench_cmd;
+extern command mux_cmd;
+extern command mqping_cmd;
+extern command top_cmd;
+extern command trace_cmd;
 
  
 extern command *all_commands[];
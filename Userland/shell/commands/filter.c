@@ -5,22 +5,31 @@
 #include "stdio.h"
 #include "stddef.h"
 #include "ctype.h"
+#include "unistd.h"
 #include "commands.h"
 
+#define FILTER_CHUNK_SIZE 512
+
 static int filter_func(int argc, char **argv)
 {
-    int c;
+    char chunk[FILTER_CHUNK_SIZE];
+    int64_t n;
 
      
-    while ((c = getchar()) != EOF)
+    while ((n = (int64_t)sys_read(STDIN, chunk, FILTER_CHUNK_SIZE)) > 0)
     {
-        char lower = tolower(c);
-         
-        if (lower == 'a' || lower == 'e' || lower == 'i' ||
-            lower == 'o' || lower == 'u')
+        int64_t kept = 0;
+        for (int64_t i = 0; i < n; i++)
         {
-            putchar(c);  
+            char lower = tolower(chunk[i]);
+             
+            if (lower == 'a' || lower == 'e' || lower == 'i' ||
+                lower == 'o' || lower == 'u')
+            {
+                chunk[kept++] = chunk[i];
+            }
         }
+        sys_write(STDOUT, chunk, (uint64_t)kept);
     }
 
      
@@ -36,7 +36,7 @@ static int loop_func(int argc, char **argv) {
         return -1;
     }
 
-    int64_t pid = sys_get_pid();
+    int pid = getpid();
     int loop_count = 0;
 
     while (1) { //-V776
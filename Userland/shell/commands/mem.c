@@ -7,13 +7,15 @@
 #include "stdio.h"
 #include "unistd.h"
 #include "stddef.h"
+#include "string.h"
+#include "stdlib.h"
 
 static int mem_func(int argc, char **argv) {
-    uint64_t total = 0, free = 0, used = 0;
+    uint64_t total = 0, free_mem = 0, used = 0;
     char manager_name[32] = {0};
 
      
-    sys_mem_state((uint64_t)&total, (uint64_t)&free, (uint64_t)&used, (uint64_t)manager_name);
+    sys_mem_state((uint64_t)&total, (uint64_t)&free_mem, (uint64_t)&used, (uint64_t)manager_name);
 
      
     void *args[1];
@@ -24,14 +26,14 @@ static int mem_func(int argc, char **argv) {
      
     int total_int = (int)total;
     int used_int = (int)used;
-    int free_int = (int)free;
+    int free_int = (int)free_mem;
 
      
     int total_kb = (int)(total / 1024);
     int total_mb = (int)(total_kb / 1024);
     int used_kb = (int)(used / 1024);
     int used_mb = (int)(used_kb / 1024);
-    int free_kb = (int)(free / 1024);
+    int free_kb = (int)(free_mem / 1024);
     int free_mb = (int)(free_kb / 1024);
 
      
@@ -50,13 +52,41 @@ static int mem_func(int argc, char **argv) {
     #ifdef BUDDY
     int total_pages = (int)(total / 4096);
     int used_pages = (int)(used / 4096);
-    int free_pages = (int)(free / 4096);
+    int free_pages = (int)(free_mem / 4096);
 
     void *page_args[3] = {&total_pages, &used_pages, &free_pages};
     printf("\nPage Statistics:\n", NULL);
     printf("Total Pages: %d | Used Pages: %d | Free Pages: %d\n", page_args);
     #endif
 
+    // A null buffer asks the kernel how many caches exist, so the listing never needs a size of its own.
+    int64_t capacity = sys_get_kmem_info(NULL, 0);
+    KmemCacheInfo *caches = capacity > 0 ? (KmemCacheInfo *)malloc(capacity * sizeof(KmemCacheInfo)) : NULL;
+    int64_t cache_count = caches != NULL ? sys_get_kmem_info(caches, capacity) : 0;
+
+    if (cache_count > 0)
+    {
+        printf("\nKernel Object Caches:\n", NULL);
+        printf("CACHE            | OBJ SIZE | IN USE | TOTAL | SLABS\n", NULL);
+
+        for (int i = 0; i < cache_count; i++)
+        {
+            args[0] = caches[i].name;
+            printf("%s", args);
+            for (int j = strlen(caches[i].name); j < 17; j++)
+                printf(" ", NULL);
+
+            int object_size = (int)caches[i].object_size;
+            int in_use = (int)caches[i].objects_in_use;
+            int total_objects = (int)caches[i].objects_total;
+            int slabs = (int)caches[i].slabs;
+            void *cache_args[4] = {&object_size, &in_use, &total_objects, &slabs};
+            printf("| %d | %d | %d | %d\n", cache_args);
+        }
+    }
+
+    free(caches);
+
     return 0;
 }
 
@@ -0,0 +1,107 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//-V:printf:576
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stddef.h>
+#include "../commands/commands.h"
+
+#define DEFAULT_ROUNDS 10000
+#define REQUEST_QUEUE 10
+#define RESPONSE_QUEUE 11
+#define QUEUE_DEPTH 16
+#define MESSAGE_SIZE 64
+#define NORMAL_PRIORITY 0
+#define STOP_PRIORITY (MQ_PRIORITIES - 1)
+
+typedef struct {
+    int sequence;
+    char payload[MESSAGE_SIZE - sizeof(int)];
+} Request;
+
+static int mqping_server(int argc, char **argv) {
+    Request request;
+    uint8_t priority;
+
+    while (sys_mq_receive(REQUEST_QUEUE, &request, sizeof(request), &priority) >= 0) {
+        // A stop request jumps ahead of anything still queued.
+        if (priority == STOP_PRIORITY) {
+            break;
+        }
+        sys_mq_send(RESPONSE_QUEUE, &request, sizeof(request), NORMAL_PRIORITY);
+    }
+    return 0;
+}
+
+int mqping_main(int argc, char **argv) {
+    void *args[1] = {NULL};
+    int rounds = DEFAULT_ROUNDS;
+
+    if (argc > 2) {
+        printf("Usage: mqping [rounds]\n", args);
+        return 1;
+    }
+
+    if (argc == 2) {
+        rounds = atoi(argv[1]);
+        if (rounds <= 0) {
+            args[0] = argv[1];
+            printf("Invalid rounds: %s\n", args);
+            return 1;
+        }
+    }
+
+    if (sys_mq_create(REQUEST_QUEUE, QUEUE_DEPTH, MESSAGE_SIZE) < 0) {
+        printf("Failed to create request queue\n", NULL);
+        return 1;
+    }
+    if (sys_mq_create(RESPONSE_QUEUE, QUEUE_DEPTH, MESSAGE_SIZE) < 0) {
+        printf("Failed to create response queue\n", NULL);
+        sys_mq_destroy(REQUEST_QUEUE);
+        return 1;
+    }
+
+    char *server_args[] = {"mqping_server", NULL};
+    int16_t fds[3] = {DEV_NULL, STDOUT, STDERR};
+    int64_t server = create_process_with_fds((void *)mqping_server, server_args, "mqping_server", 1, fds);
+
+    int failed = server < 0;
+    Request request;
+    Request response;
+    uint64_t start = get_time_ns();
+
+    for (int i = 0; i < rounds && !failed; i++) {
+        request.sequence = i;
+        failed = sys_mq_send(REQUEST_QUEUE, &request, sizeof(request), NORMAL_PRIORITY) < 0 ||
+                 sys_mq_receive(RESPONSE_QUEUE, &response, sizeof(response), NULL) < 0 ||
+                 response.sequence != i;
+    }
+
+    uint64_t elapsed = get_time_ns() - start;
+
+    if (server >= 0) {
+        sys_mq_send(REQUEST_QUEUE, &request, sizeof(request), STOP_PRIORITY);
+        waitpid((uint16_t)server);
+    }
+    sys_mq_destroy(REQUEST_QUEUE);
+    sys_mq_destroy(RESPONSE_QUEUE);
+
+    if (failed) {
+        printf("Message exchange failed\n", NULL);
+        return 1;
+    }
+
+    int ns_per_round_trip = (int)(elapsed / (uint64_t)rounds);
+    args[0] = &ns_per_round_trip;
+    printf("Round trip: %d ns\n", args);
+    return 0;
+}
+
+command mqping_cmd = {
+    "mqping",
+    mqping_main,
+    "Measure request/response latency over message queues"
+};
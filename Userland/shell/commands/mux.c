@@ -0,0 +1,123 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//-V:printf:576
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <stddef.h>
+#include "../commands/commands.h"
+
+#define PRODUCERS 2
+#define MESSAGES 5
+#define BUFFER_SIZE 128
+
+static int mux_producer(int argc, char **argv) {
+    int delay_ms = atoi(argv[2]);
+    char line[BUFFER_SIZE];
+    char num[12];
+
+    for (int i = 0; i < MESSAGES; i++) {
+        strcpy(line, argv[1]);
+        strcat(line, ": message ");
+        strcat(line, itoa(i, num));
+        strcat(line, "\n");
+        sys_write(STDOUT, line, strlen(line));
+        sys_sleep_ms((uint64_t)delay_ms);
+    }
+    return 0;
+}
+
+static void stop_producers(int16_t *pipes, int64_t *pids, int count) {
+    for (int i = 0; i < count; i++) {
+        if (pids[i] >= 0) {
+            sys_kill_process((uint64_t)pids[i], 0);
+            waitpid((uint16_t)pids[i]);
+        }
+        sys_pipe_close((uint16_t)pipes[i], PIPE_READ);
+    }
+}
+
+int mux_main(int argc, char **argv) {
+    static char *names[PRODUCERS] = {"fast", "slow"};
+    static char *delays[PRODUCERS] = {"300", "1000"};
+    int16_t pipes[PRODUCERS];
+    int64_t pids[PRODUCERS];
+    PollFd fds[PRODUCERS + 1];
+    char buffer[BUFFER_SIZE];
+    int open_pipes = 0;
+
+    for (int i = 0; i < PRODUCERS; i++) {
+        pipes[i] = pipe_get();
+        if (pipes[i] < 0 || sys_pipe_open((uint16_t)pipes[i], PIPE_READ) < 0) {
+            printf("Failed to create pipe\n", NULL);
+            stop_producers(pipes, pids, i);
+            return 1;
+        }
+        sys_set_fd_flags((uint64_t)pipes[i], O_NONBLOCK);
+
+        char *child_args[] = {names[i], names[i], delays[i], NULL};
+        int16_t child_fds[3] = {DEV_NULL, pipes[i], STDERR};
+        pids[i] = create_process_with_fds((void *)mux_producer, child_args, names[i], 1, child_fds);
+
+        // A pipe with no producer is polled as /dev/null, which never reports anything for no events.
+        fds[i].fd = DEV_NULL;
+        fds[i].events = 0;
+        if (pids[i] < 0) {
+            printf("Failed to create producer\n", NULL);
+            continue;
+        }
+        fds[i].fd = pipes[i];
+        fds[i].events = POLLIN;
+        open_pipes++;
+    }
+
+    fds[PRODUCERS].fd = STDIN;
+    fds[PRODUCERS].events = POLLIN;
+
+    printf("Polling both producers; press q to quit\n", NULL);
+
+    while (open_pipes > 0) {
+        if (sys_poll(fds, PRODUCERS + 1, POLL_NO_TIMEOUT) < 0) {
+            break;
+        }
+
+        for (int i = 0; i < PRODUCERS; i++) {
+            if (!(fds[i].revents & (POLLIN | POLLHUP))) {
+                continue;
+            }
+
+            int64_t n;
+            while ((n = (int64_t)sys_read((uint64_t)pipes[i], buffer, BUFFER_SIZE)) > 0) {
+                sys_write(STDOUT, buffer, (uint64_t)n);
+            }
+
+            // A closed pipe keeps reporting POLLHUP, so it leaves the poll set for good.
+            if (n == 0) {
+                fds[i].fd = DEV_NULL;
+                fds[i].events = 0;
+                open_pipes--;
+            }
+        }
+
+        if (fds[PRODUCERS].revents & POLLIN) {
+            int c = getchar();
+            if (c == EOF) {
+                fds[PRODUCERS].events = 0;
+            } else if (c == 'q') {
+                break;
+            }
+        }
+    }
+
+    stop_producers(pipes, pids, PRODUCERS);
+    return 0;
+}
+
+command mux_cmd = {
+    "mux",
+    mux_main,
+    "Multiplex two producers and the keyboard with poll"
+};
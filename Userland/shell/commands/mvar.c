@@ -16,15 +16,13 @@
 #define MVAR_MUTEX 100
 #define MVAR_READ_SEM 101
 #define MVAR_WRITE_SEM 102
+#define MVAR_SHM 1
 
 #define STDIN 0
 #define STDOUT 1
 #define STDERR 2
 
  
-static char shared_mvar = 0;
-
- 
 static void build_name(char *dest, const char *prefix, int num)
 {
     char num_str[12];  
@@ -64,6 +62,13 @@ static uint64_t writer_process(uint64_t argc, char *argv[])
         return -1;
     }
 
+    char *shared_mvar = (char *)sys_shm_attach(MVAR_SHM);
+    if (shared_mvar == NULL)
+    {
+        puts("Writer: ERROR attaching shared memory\n");
+        return -1;
+    }
+
      
     while (1)  
     {
@@ -86,7 +91,7 @@ static uint64_t writer_process(uint64_t argc, char *argv[])
         }
 
          
-        shared_mvar = my_letter;
+        *shared_mvar = my_letter;
 
          
         if (sys_sem_post(MVAR_MUTEX) < 0)
@@ -123,6 +128,13 @@ static uint64_t reader_process(uint64_t argc, char *argv[])
         return -1;
     }
 
+    char *shared_mvar = (char *)sys_shm_attach(MVAR_SHM);
+    if (shared_mvar == NULL)
+    {
+        puts("Reader: ERROR attaching shared memory\n");
+        return -1;
+    }
+
      
     while (1)  
     {
@@ -145,7 +157,7 @@ static uint64_t reader_process(uint64_t argc, char *argv[])
         }
 
          
-        char value = shared_mvar;
+        char value = *shared_mvar;
 
          
         if (sys_sem_post(MVAR_MUTEX) < 0)
@@ -216,6 +228,15 @@ static int mvar_func(int argc, char **argv)
         return -1;
     }
 
+    if (sys_shm_create(MVAR_SHM, sizeof(char)) < 0)
+    {
+        puts("mvar: ERROR creating shared memory\n");
+        sys_sem_destroy(MVAR_MUTEX);
+        sys_sem_destroy(MVAR_READ_SEM);
+        sys_sem_destroy(MVAR_WRITE_SEM);
+        return -1;
+    }
+
      
     int16_t default_fds[3] = {STDIN, STDOUT, STDERR};
 
@@ -236,6 +257,7 @@ static int mvar_func(int argc, char **argv)
             sys_sem_destroy(MVAR_MUTEX);
             sys_sem_destroy(MVAR_READ_SEM);
             sys_sem_destroy(MVAR_WRITE_SEM);
+            sys_shm_destroy(MVAR_SHM);
             return -1;
         }
     }
@@ -257,6 +279,7 @@ static int mvar_func(int argc, char **argv)
             sys_sem_destroy(MVAR_MUTEX);
             sys_sem_destroy(MVAR_READ_SEM);
             sys_sem_destroy(MVAR_WRITE_SEM);
+            sys_shm_destroy(MVAR_SHM);
             return -1;
         }
     }
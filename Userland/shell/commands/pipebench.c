@@ -0,0 +1,135 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//-V:printf:576
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stddef.h>
+#include <string.h>
+#include "../commands/commands.h"
+
+#define DEFAULT_KILOBYTES 1024
+#define CHUNK_SIZE 512
+
+static int pipebench_writer(int argc, char **argv) {
+    char chunk[CHUNK_SIZE];
+    int total = atoi(argv[1]) * 1024;
+
+    for (int i = 0; i < CHUNK_SIZE; i++) {
+        chunk[i] = (char)i;
+    }
+
+    for (int sent = 0; sent < total; sent += CHUNK_SIZE) {
+        sys_write(STDOUT, chunk, CHUNK_SIZE);
+    }
+    return 0;
+}
+
+static int pipebench_reader(int argc, char **argv) {
+    char chunk[CHUNK_SIZE];
+    int total = atoi(argv[1]) * 1024;
+    int received = 0;
+    int corrupted = 0;
+    int64_t n;
+
+    while ((n = (int64_t)sys_read(STDIN, chunk, CHUNK_SIZE)) > 0) {
+        for (int64_t i = 0; i < n; i++) {
+            if ((unsigned char)chunk[i] != (unsigned char)(received + i)) {
+                corrupted = 1;
+            }
+        }
+        received += (int)n;
+    }
+
+    if (corrupted || received != total) {
+        const char *msg = "pipebench: data corrupted\n";
+        sys_write(STDERR, msg, strlen(msg));
+        return 1;
+    }
+    return 0;
+}
+
+int pipebench_main(int argc, char **argv) {
+    void *args[2] = {NULL, NULL};
+    int kilobytes = DEFAULT_KILOBYTES;
+    int capacity = 0;
+
+    if (argc > 3) {
+        printf("Usage: pipebench [kilobytes] [capacity]\n", args);
+        return 1;
+    }
+
+    if (argc >= 2) {
+        kilobytes = atoi(argv[1]);
+        if (kilobytes <= 0) {
+            args[0] = argv[1];
+            printf("Invalid size: %s\n", args);
+            return 1;
+        }
+    }
+
+    if (argc == 3) {
+        capacity = atoi(argv[2]);
+        if (capacity <= 0) {
+            args[0] = argv[2];
+            printf("Invalid capacity: %s\n", args);
+            return 1;
+        }
+    }
+
+    char size_arg[12];
+    itoa(kilobytes, size_arg);
+    char *child_args[] = {"pipebench", size_arg, NULL};
+
+    int16_t pipe_id = capacity > 0 ? pipe_create((uint32_t)capacity) : pipe_get();
+    if (pipe_id < 0) {
+        printf("Failed to create pipe\n", NULL);
+        return 1;
+    }
+
+    int16_t writer_fds[3] = {DEV_NULL, pipe_id, STDERR};
+    int16_t reader_fds[3] = {pipe_id, DEV_NULL, STDERR};
+
+    uint64_t start = get_time_ns();
+
+    int64_t writer = create_process_with_fds((void *)pipebench_writer, child_args, "pipebench_w", 1, writer_fds);
+    int64_t reader = create_process_with_fds((void *)pipebench_reader, child_args, "pipebench_r", 1, reader_fds);
+
+    if (writer < 0 || reader < 0) {
+        printf("Failed to create benchmark processes\n", NULL);
+        if (writer >= 0) {
+            sys_kill_process((uint64_t)writer, -1);
+        }
+        if (reader >= 0) {
+            sys_kill_process((uint64_t)reader, -1);
+        }
+        return 1;
+    }
+
+    waitpid((uint16_t)writer);
+    waitpid((uint16_t)reader);
+
+    uint64_t elapsed_us = (get_time_ns() - start) / 1000;
+    if (elapsed_us == 0) {
+        elapsed_us = 1;
+    }
+
+    int elapsed_ms = (int)(elapsed_us / 1000);
+    int throughput = (int)((uint64_t)kilobytes * 1000000 / elapsed_us);
+
+    args[0] = &kilobytes;
+    args[1] = &elapsed_ms;
+    printf("Transferred %d KB in %d ms\n", args);
+
+    args[0] = &throughput;
+    printf("Throughput: %d KB/s\n", args);
+    return 0;
+}
+
+command pipebench_cmd = {
+    "pipebench",
+    pipebench_main,
+    "Measure pipe throughput between two processes"
+};
@@ -8,8 +8,7 @@
 #include "commands.h"
 #include "unistd.h"
 #include "string.h"
-
-#define MAX_PROCESS_COUNT 20
+#include "stdlib.h"
 
 static const char *status_to_string(ProcessStatus status)
 {
@@ -45,13 +44,21 @@ static void uint64_to_hex(uint64_t value, char *buffer)
 
 static int ps_func(int argc, char **argv)
 {
-    ProcessInfo processes[MAX_PROCESS_COUNT];
+    // A null buffer asks for the process count; a few spare entries cover processes created meanwhile.
+    int64_t capacity = sys_get_process_info(NULL, 0) + 8;
+    ProcessInfo *processes = (ProcessInfo *)malloc(capacity * sizeof(ProcessInfo));
+    if (processes == NULL)
+    {
+        printf("Error: Not enough memory\n", NULL);
+        return -1;
+    }
 
-    int64_t count = sys_get_process_info(processes, MAX_PROCESS_COUNT);
+    int64_t count = sys_get_process_info(processes, capacity);
 
     if (count < 0)
     {
         printf("Error: Failed to retrieve process information\n", NULL);
+        free(processes);
         return -1;
     }
 
@@ -156,6 +163,7 @@ static int ps_func(int argc, char **argv)
     total_args[0] = &total_count;
     printf("Total processes: %d\n", total_args);
 
+    free(processes);
     return 0;
 }
 
@@ -0,0 +1,71 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//-V:printf:576
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stddef.h>
+#include "../commands/commands.h"
+
+#define DEFAULT_ITERATIONS 100000
+
+typedef uint64_t (*SyscallFunction)(void);
+
+static uint64_t info_page_get_pid(void) {
+    return getpid();
+}
+
+static int ns_per_call(SyscallFunction function, int iterations) {
+    uint64_t start = get_time_ns();
+
+    for (int i = 0; i < iterations; i++) {
+        function();
+    }
+
+    uint64_t elapsed = get_time_ns() - start;
+    return (int)(elapsed / (uint64_t)iterations);
+}
+
+int sysbench_main(int argc, char **argv) {
+    void *args[2] = {NULL, NULL};
+    int iterations = DEFAULT_ITERATIONS;
+
+    if (argc > 2) {
+        printf("Usage: sysbench [iterations]\n", args);
+        return 1;
+    }
+
+    if (argc == 2) {
+        iterations = atoi(argv[1]);
+        if (iterations <= 0) {
+            args[0] = argv[1];
+            printf("Invalid iteration count: %s\n", args);
+            return 1;
+        }
+    }
+
+    int fast = ns_per_call(sys_get_pid, iterations);
+    int trap = ns_per_call(sys_get_pid_int80, iterations);
+    int page = ns_per_call(info_page_get_pid, iterations);
+
+    args[0] = &iterations;
+    printf("sys_get_pid x %d\n", args);
+
+    args[0] = &fast;
+    printf("  SYSCALL:  %d ns/call\n", args);
+
+    args[0] = &trap;
+    printf("  int 0x80: %d ns/call\n", args);
+
+    args[0] = &page;
+    printf("  info page (getpid): %d ns/call\n", args);
+    return 0;
+}
+
+command sysbench_cmd = {
+    "sysbench",
+    sysbench_main,
+    "Compare SYSCALL, int 0x80 and info page get_pid cost"
+};
@@ -0,0 +1,21 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//-V:printf:576
+
+
+#include "stdint.h"
+#include "stddef.h"
+#include "stdio.h"
+#include "commands.h"
+
+extern uint64_t test_rwlock(uint64_t argc, char *argv[]);
+
+static int test_rwlock_func(int argc, char **argv)
+{
+    return test_rwlock(0, NULL);
+}
+
+command test_rwlock_cmd = {
+    "test-rwlock",
+    test_rwlock_func,
+    "Run concurrent readers and writers over a rwlock, barrier and condvar"};
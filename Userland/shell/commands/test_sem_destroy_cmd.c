@@ -0,0 +1,21 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//-V:printf:576
+
+
+#include "stdint.h"
+#include "stddef.h"
+#include "stdio.h"
+#include "commands.h"
+
+extern uint64_t test_sem_destroy(uint64_t argc, char *argv[]);
+
+static int test_sem_destroy_func(int argc, char **argv)
+{
+    return test_sem_destroy(0, NULL);
+}
+
+command test_sem_destroy_cmd = {
+    "test-sem-destroy",
+    test_sem_destroy_func,
+    "Destroy a semaphore under a blocked sem_wait and sem_timedwait"};
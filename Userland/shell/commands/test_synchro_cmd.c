@@ -5,6 +5,7 @@
 #include "stdint.h"
 #include "stddef.h"
 #include "stdio.h"
+#include "string.h"
 #include "commands.h"
 
 extern uint64_t test_sync(uint64_t argc, char *argv[]);
@@ -12,14 +13,21 @@ extern uint64_t test_sync(uint64_t argc, char *argv[]);
 static int test_synchro_func(int argc, char **argv)
 {
 
-    if (argc != 2)
+    char *mode = "1";
+    if (argc == 3 && strcmp(argv[2], "futex") == 0)
+        mode = "2";
+    else if (argc == 3 && strcmp(argv[2], "inherit") == 0)
+        mode = "3";
+    else if (argc != 2)
     {
-        printf("Usage: test-synchro <n>\n", NULL);
+        printf("Usage: test-synchro <n> [futex|inherit]\n", NULL);
         printf("  n: number of iterations\n", NULL);
+        printf("  futex: use the userland futex mutex instead of a kernel semaphore\n", NULL);
+        printf("  inherit: use a kernel mutex with priority inheritance\n", NULL);
         return -1;
     }
 
-    char *sync_argv[] = {argv[1], "1"};
+    char *sync_argv[] = {argv[1], mode};
     return test_sync(2, sync_argv);
 }
 
@@ -0,0 +1,191 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//-V:printf:576
+
+
+#include "stdio.h"
+#include "stddef.h"
+#include "stdlib.h"
+#include "string.h"
+#include "unistd.h"
+#include "commands.h"
+
+#define TOP_ROWS 20
+#define SPARE_ENTRIES 8
+
+static const char *status_to_string(ProcessStatus status)
+{
+    switch (status)
+    {
+    case READY:
+        return "RDY";
+    case RUNNING:
+        return "RUN";
+    case BLOCKED:
+        return "BLK";
+    case ZOMBIE:
+        return "ZMB";
+    default:
+        return "?";
+    }
+}
+
+static void print_cell(const char *text, int width)
+{
+    void *args[1] = {(void *)text};
+    printf("%s", args);
+
+    for (int i = strlen(text); i < width; i++)
+        printf(" ", NULL);
+    printf("| ", NULL);
+}
+
+static void print_number(uint64_t value, int width)
+{
+    char buffer[12];
+    print_cell(itoa((int)value, buffer), width);
+}
+
+static uint64_t ticks_to_ms(uint64_t ticks, uint32_t tick_hz)
+{
+    return ticks * 1000 / tick_hz;
+}
+
+static ProcessInfo *take_snapshot(int64_t *count)
+{
+    int64_t capacity = sys_get_process_info(NULL, 0) + SPARE_ENTRIES;
+    ProcessInfo *snapshot = (ProcessInfo *)malloc(capacity * sizeof(ProcessInfo));
+    if (snapshot == NULL)
+        return NULL;
+
+    *count = sys_get_process_info(snapshot, capacity);
+    if (*count < 0)
+    {
+        free(snapshot);
+        return NULL;
+    }
+    return snapshot;
+}
+
+// Both snapshots come sorted by pid, so the previous run time is found with one forward scan.
+static void compute_deltas(ProcessInfo *previous, int64_t previous_count,
+                           ProcessInfo *current, int64_t current_count, int64_t *deltas)
+{
+    int64_t j = 0;
+    for (int64_t i = 0; i < current_count; i++)
+    {
+        while (j < previous_count && previous[j].pid < current[i].pid)
+            j++;
+
+        uint64_t before = (j < previous_count && previous[j].pid == current[i].pid) ? previous[j].run_ticks : 0;
+        deltas[i] = (int64_t)(current[i].run_ticks - before);
+    }
+}
+
+static void print_row(ProcessInfo *process, int64_t delta, uint64_t interval, uint32_t tick_hz)
+{
+    char cpu[4] = "-";
+
+    print_number(process->pid, 5);
+    print_cell(process->name, 16);
+    print_cell(status_to_string(process->status), 3);
+    print_number(process->priority, 3);
+    if (process->last_cpu != NO_CPU)
+        itoa(process->last_cpu, cpu);
+    print_cell(cpu, 3);
+    print_number(interval > 0 ? (uint64_t)delta * 100 / interval : 0, 4);
+    print_number(ticks_to_ms(process->run_ticks, tick_hz), 8);
+    print_number(ticks_to_ms(process->ready_ticks, tick_hz), 8);
+    print_number(ticks_to_ms(process->blocked_ticks, tick_hz), 8);
+    print_number(process->voluntary_switches, 6);
+
+    char buffer[12];
+    void *args[1] = {itoa((int)process->involuntary_switches, buffer)};
+    printf("%s\n", args);
+}
+
+// Highest CPU share over the last interval first; a delta of -1 marks rows already printed.
+static void print_screen(ProcessInfo *current, int64_t count, int64_t *deltas, uint64_t interval)
+{
+    const KernelInfoPage *info = kernel_info();
+    int total = (int)count;
+    int cpus = info->cpu_count;
+    void *args[2] = {&total, &cpus};
+
+    sys_clear_text_buffer();
+    printf("top - %d processes, %d CPUs - press q to quit\n\n", args);
+    // puts, not printf: the header has a literal percent sign.
+    puts("PID  | NAME            | ST | PRI| CPU| CPU%| TIME ms | READY ms| BLK ms  | VCSW  | ICSW\n");
+
+    for (int row = 0; row < TOP_ROWS; row++)
+    {
+        int64_t best = -1;
+        for (int64_t i = 0; i < count; i++)
+        {
+            if (deltas[i] >= 0 && (best < 0 || deltas[i] > deltas[best]))
+                best = i;
+        }
+        if (best < 0)
+            break;
+
+        print_row(&current[best], deltas[best], interval, info->tick_hz);
+        deltas[best] = -1;
+    }
+}
+
+static int top_func(int argc, char **argv)
+{
+    int refreshes = argc > 1 ? atoi(argv[1]) : -1;
+    PollFd keyboard = {STDIN, POLLIN, 0};
+    uint32_t tick_hz = kernel_info()->tick_hz;
+
+    int64_t previous_count;
+    ProcessInfo *previous = take_snapshot(&previous_count);
+    if (previous == NULL)
+    {
+        printf("Error: Failed to retrieve process information\n", NULL);
+        return -1;
+    }
+    uint64_t previous_ticks = get_ticks();
+
+    while (refreshes != 0)
+    {
+        if (sys_poll(&keyboard, 1, tick_hz) > 0 && (keyboard.revents & POLLIN))
+        {
+            int c = getchar();
+            if (c == 'q' || c == EOF)
+                break;
+        }
+
+        int64_t count;
+        ProcessInfo *current = take_snapshot(&count);
+        uint64_t now = get_ticks();
+        int64_t *deltas = current != NULL ? (int64_t *)malloc(count * sizeof(int64_t)) : NULL;
+        if (deltas == NULL)
+        {
+            free(current);
+            printf("Error: Not enough memory\n", NULL);
+            break;
+        }
+
+        compute_deltas(previous, previous_count, current, count, deltas);
+        print_screen(current, count, deltas, now - previous_ticks);
+
+        free(deltas);
+        free(previous);
+        previous = current;
+        previous_count = count;
+        previous_ticks = now;
+
+        if (refreshes > 0)
+            refreshes--;
+    }
+
+    free(previous);
+    return 0;
+}
+
+command top_cmd = {
+    "top",
+    top_func,
+    "Show processes by CPU usage, refreshing every second"};
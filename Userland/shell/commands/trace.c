@@ -0,0 +1,146 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//-V:printf:576
+
+
+#include "stdio.h"
+#include "stddef.h"
+#include "stdlib.h"
+#include "unistd.h"
+#include "commands.h"
+
+static const char *event_names[] = {"SWITCH_IN", "SWITCH_OUT", "BLOCK", "UNBLOCK", "AGING", "KILL"};
+static const char *reason_names[] = {"other", "pipe", "semaphore", "waitpid", "keyboard", "sleep",
+                                     "poll", "futex", "mqueue", "sync", "manual"};
+
+static const char *reason_to_string(uint8_t reason)
+{
+    return reason < sizeof(reason_names) / sizeof(reason_names[0]) ? reason_names[reason] : "?";
+}
+
+static void print_event(TraceEvent *event)
+{
+    int tick = (int)event->tick;
+    int cpu = event->cpu;
+    int pid = event->pid;
+    const char *name = event->type <= TRACE_KILL ? event_names[event->type] : "?";
+    void *args[4] = {&tick, &cpu, &pid, (void *)name};
+    printf("%d cpu%d pid %d %s", args);
+
+    int arg = event->arg;
+    void *detail[1] = {&arg};
+    switch (event->type)
+    {
+    case TRACE_SWITCH_IN:
+    case TRACE_AGING:
+        printf(" prio %d", detail);
+        break;
+    case TRACE_SWITCH_OUT:
+        printf(arg ? " voluntary" : " preempted", NULL);
+        break;
+    case TRACE_BLOCK:
+    case TRACE_UNBLOCK:
+        detail[0] = (void *)reason_to_string(event->arg);
+        printf(" %s", detail);
+        break;
+    default:
+        break;
+    }
+    printf("\n", NULL);
+}
+
+// Wakeup latency: ticks from an UNBLOCK until that same process is next switched in. An UNBLOCK
+// followed by another UNBLOCK or BLOCK of the same pid before any SWITCH_IN never completed, so it is dropped.
+static void print_latencies(TraceEvent *events, int count, uint32_t tick_hz)
+{
+    int wakeups = 0;
+    uint64_t total = 0;
+    uint64_t worst = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (events[i].type != TRACE_UNBLOCK)
+            continue;
+
+        for (int j = i + 1; j < count; j++)
+        {
+            if (events[j].pid != events[i].pid)
+                continue;
+            if (events[j].type == TRACE_SWITCH_IN)
+            {
+                uint64_t latency = events[j].tick - events[i].tick;
+                total += latency;
+                if (latency > worst)
+                    worst = latency;
+                wakeups++;
+            }
+            if (events[j].type == TRACE_SWITCH_IN || events[j].type == TRACE_KILL ||
+                events[j].type == TRACE_UNBLOCK || events[j].type == TRACE_BLOCK)
+                break;
+        }
+    }
+
+    if (wakeups == 0)
+    {
+        printf("No completed wakeups in the trace\n", NULL);
+        return;
+    }
+
+    int average = (int)(total * 1000 / wakeups / tick_hz);
+    int max = (int)(worst * 1000 / tick_hz);
+    int max_ticks = (int)worst;
+    void *args[4] = {&wakeups, &average, &max, &max_ticks};
+    printf("Wakeup latency over %d wakeups: avg %d ms, max %d ms (%d ticks)\n", args);
+}
+
+static int trace_func(int argc, char **argv)
+{
+    TraceEvent *events = (TraceEvent *)malloc(TRACE_CAPACITY * sizeof(TraceEvent));
+    if (events == NULL)
+    {
+        printf("Error: Not enough memory\n", NULL);
+        return -1;
+    }
+
+    uint32_t dropped = 0;
+
+    // With a window, start from an empty ring so only that interval is shown.
+    if (argc > 1)
+    {
+        int ms = atoi(argv[1]);
+        if (ms <= 0)
+        {
+            printf("Usage: trace [ms]\n", NULL);
+            free(events);
+            return -1;
+        }
+        while (sys_trace_drain(events, TRACE_CAPACITY, &dropped) > 0)
+            ;
+        sys_sleep_ms(ms);
+    }
+
+    int64_t count = sys_trace_drain(events, TRACE_CAPACITY, &dropped);
+    if (count < 0)
+    {
+        printf("Error: Failed to read the scheduler trace\n", NULL);
+        free(events);
+        return -1;
+    }
+
+    for (int i = 0; i < count; i++)
+        print_event(&events[i]);
+
+    int shown = (int)count;
+    int lost = (int)dropped;
+    void *args[2] = {&shown, &lost};
+    printf("%d events, %d dropped\n", args);
+    print_latencies(events, (int)count, kernel_info()->tick_hz);
+
+    free(events);
+    return 0;
+}
+
+command trace_cmd = {
+    "trace",
+    trace_func,
+    "Dump scheduler events and wakeup latencies, optionally over a window in ms"};
@@ -5,16 +5,22 @@
  
 #include "stdio.h"
 #include "stddef.h"
+#include "unistd.h"
 #include "commands.h"
 
+#define WC_CHUNK_SIZE 512
+
 static int wc_func(int argc, char **argv) {
-    int c;
+    char chunk[WC_CHUNK_SIZE];
+    int64_t n;
     int line_count = 0;
 
      
-    while ((c = getchar()) != EOF) {
-        if (c == '\n') {
-            line_count++;
+    while ((n = (int64_t)sys_read(STDIN, chunk, WC_CHUNK_SIZE)) > 0) {
+        for (int64_t i = 0; i < n; i++) {
+            if (chunk[i] == '\n') {
+                line_count++;
+            }
         }
     }
 
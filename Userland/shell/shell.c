@@ -40,6 +40,8 @@ extern command clear_cmd;
 extern command help_cmd;
 extern command test_synchro_cmd;
 extern command test_no_synchro_cmd;
+extern command test_sem_destroy_cmd;
+extern command test_rwlock_cmd;
 extern command test_processes_cmd;
 extern command test_mm_cmd;
 extern command ps_cmd;
@@ -53,6 +55,12 @@ extern command wc_cmd;
 extern command mem_cmd;
 extern command filter_cmd;
 extern command mvar_cmd;
+extern command sysbench_cmd;
+extern command pipebench_cmd;
+extern command mux_cmd;
+extern command mqping_cmd;
+extern command top_cmd;
+extern command trace_cmd;
 
  
 command *all_commands[] = {
@@ -60,6 +68,8 @@ command *all_commands[] = {
     &help_cmd,
     &test_synchro_cmd,
     &test_no_synchro_cmd,
+    &test_sem_destroy_cmd,
+    &test_rwlock_cmd,
     &test_processes_cmd,
     &test_mm_cmd,
     &ps_cmd,
@@ -72,6 +82,12 @@ command *all_commands[] = {
     &mem_cmd,
     &filter_cmd,
     &mvar_cmd,
+    &sysbench_cmd,
+    &pipebench_cmd,
+    &mux_cmd,
+    &mqping_cmd,
+    &top_cmd,
+    &trace_cmd,
     NULL  
 };
 
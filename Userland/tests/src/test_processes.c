@@ -5,6 +5,7 @@
 #include "stdint.h"
 #include "stdio.h"
 #include "stddef.h"
+#include "stdlib.h"
 #include "unistd.h"
 #include "test_util.h"
 
@@ -33,8 +34,8 @@ uint64_t endless_loop_func(uint64_t argc, char *argv[])
 
 int64_t test_processes(uint64_t argc, char *argv[])
 {
-  uint8_t rq;
-  uint8_t alive = 0;
+  uint64_t rq;
+  uint64_t alive = 0;
   uint8_t action;
   uint64_t max_processes;
   char *argvAux[] = {0};
@@ -45,7 +46,13 @@ int64_t test_processes(uint64_t argc, char *argv[])
   if ((max_processes = satoi(argv[0])) <= 0)
     return -1;
 
-  p_rq p_rqs[max_processes];
+  // Heap-allocated: a thousand entries would not fit in a process stack.
+  p_rq *p_rqs = (p_rq *)malloc(max_processes * sizeof(p_rq));
+  if (p_rqs == NULL)
+  {
+    puts("test_processes: ERROR allocating process table\n");
+    return -1;
+  }
   int16_t default_fds[3] = {STDIN, STDOUT, STDERR};
 
   while (1)
@@ -59,6 +66,7 @@ int64_t test_processes(uint64_t argc, char *argv[])
       if (p_rqs[rq].pid == -1)
       {
         puts("test_processes: ERROR creating process\n");
+        free(p_rqs);
         return -1;
       }
       else
@@ -84,6 +92,7 @@ int64_t test_processes(uint64_t argc, char *argv[])
             if ((int64_t)sys_kill_process(p_rqs[rq].pid, -1) == -1)
             {
               puts("test_processes: ERROR killing process\n");
+              free(p_rqs);
               return -1;
             }
             p_rqs[rq].state = TEST_KILLED;
@@ -98,6 +107,7 @@ int64_t test_processes(uint64_t argc, char *argv[])
             if ((int64_t)sys_block(p_rqs[rq].pid) == -1)
             {
               puts("test_processes: ERROR blocking process\n");
+              free(p_rqs);
               return -1;
             }
             p_rqs[rq].state = TEST_BLOCKED;
@@ -113,6 +123,7 @@ int64_t test_processes(uint64_t argc, char *argv[])
           if ((int64_t)sys_unblock(p_rqs[rq].pid) == -1)
           {
             puts("test_processes: ERROR unblocking process\n");
+            free(p_rqs);
             return -1;
           }
           p_rqs[rq].state = TEST_RUNNING;
@@ -0,0 +1,155 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+
+#include "stdint.h"
+#include "stddef.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "unistd.h"
+#include "test_util.h"
+
+#define LOCK_ID 8
+#define COND_ID 8
+#define BARRIER_ID 8
+#define SEM_ID 69
+
+#define READERS 4
+#define WRITERS 2
+#define ROUNDS 5
+#define HOLD_MS 30
+
+static volatile int64_t readers_inside;
+static volatile int64_t writers_inside;
+static volatile int64_t max_readers;
+static volatile int64_t violations;
+static volatile int64_t finished;
+
+static void enter(uint64_t mode)
+{
+  sys_sem_wait(SEM_ID);
+  if (mode == RWLOCK_READ)
+  {
+    readers_inside++;
+    if (readers_inside > max_readers)
+      max_readers = readers_inside;
+    if (writers_inside > 0)
+      violations++;
+  }
+  else
+  {
+    writers_inside++;
+    if (writers_inside > 1 || readers_inside > 0)
+      violations++;
+  }
+  sys_sem_post(SEM_ID);
+}
+
+static void leave(uint64_t mode)
+{
+  sys_sem_wait(SEM_ID);
+  if (mode == RWLOCK_READ)
+    readers_inside--;
+  else
+    writers_inside--;
+  sys_sem_post(SEM_ID);
+}
+
+uint64_t rwlock_worker(uint64_t argc, char *argv[])
+{
+  if (argc != 1)
+    return -1;
+
+  uint64_t mode = (uint64_t)satoi(argv[0]);
+
+  // Everyone starts contending at once, so readers get a chance to overlap.
+  sys_barrier_wait(BARRIER_ID);
+
+  for (int i = 0; i < ROUNDS; i++)
+  {
+    if (sys_rwlock_lock(LOCK_ID, mode) < 0)
+    {
+      sys_sem_wait(SEM_ID);
+      violations++;
+      sys_sem_post(SEM_ID);
+      break;
+    }
+    enter(mode);
+    sys_sleep_ms(HOLD_MS);
+    leave(mode);
+    sys_rwlock_unlock(LOCK_ID);
+    sys_sleep_ms(HOLD_MS);
+  }
+
+  sys_sem_wait(SEM_ID);
+  finished++;
+  sys_cond_signal(COND_ID);
+  sys_sem_post(SEM_ID);
+  return 0;
+}
+
+static void destroy_objects(void)
+{
+  sys_barrier_destroy(BARRIER_ID);
+  sys_cond_destroy(COND_ID);
+  sys_rwlock_destroy(LOCK_ID);
+  sys_sem_destroy(SEM_ID);
+}
+
+uint64_t test_rwlock(uint64_t argc, char *argv[])
+{
+  int64_t pids[READERS + WRITERS];
+  int16_t default_fds[3] = {STDIN, STDOUT, STDERR};
+  char *argvRead[] = {"0", NULL};
+  char *argvWrite[] = {"1", NULL};
+
+  readers_inside = 0;
+  writers_inside = 0;
+  max_readers = 0;
+  violations = 0;
+  finished = 0;
+
+  if (sys_sem_init(SEM_ID, 1) < 0 || sys_rwlock_create(LOCK_ID) < 0 ||
+      sys_cond_create(COND_ID) < 0 || sys_barrier_create(BARRIER_ID, READERS + WRITERS) < 0)
+  {
+    puts("test_rwlock: ERROR creating sync objects\n");
+    destroy_objects();
+    return -1;
+  }
+
+  for (int i = 0; i < READERS + WRITERS; i++)
+  {
+    char **args = i < READERS ? argvRead : argvWrite;
+    pids[i] = sys_create_process((uint64_t)&rwlock_worker, (uint64_t)args, (uint64_t)"rwlock_worker", 2, (uint64_t)default_fds);
+    if (pids[i] < 0)
+    {
+      puts("test_rwlock: ERROR creating worker\n");
+      for (int j = 0; j < i; j++)
+      {
+        sys_kill_process((uint64_t)pids[j], 0);
+        sys_waitpid((uint64_t)pids[j]);
+      }
+      destroy_objects();
+      return -1;
+    }
+  }
+
+  sys_sem_wait(SEM_ID);
+  while (finished < READERS + WRITERS)
+    sys_cond_wait(COND_ID, SEM_ID);
+  sys_sem_post(SEM_ID);
+
+  for (int i = 0; i < READERS + WRITERS; i++)
+    sys_waitpid((uint64_t)pids[i]);
+
+  destroy_objects();
+
+  int concurrent = (int)max_readers;
+  int broken = (int)violations;
+  void *args[2] = {&concurrent, &broken};
+  printf("Max concurrent readers: %d, exclusion violations: %d\n", args);
+
+  int ok = max_readers > 1 && violations == 0;
+  puts(ok ? "test_rwlock: OK\n" : "test_rwlock: FAILED\n");
+  return ok ? 0 : -1;
+}
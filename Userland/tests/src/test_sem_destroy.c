@@ -0,0 +1,82 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+
+#include "stdint.h"
+#include "stddef.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "unistd.h"
+#include "test_util.h"
+
+#define SEM_ID 68
+#define WAITER_TIMEOUT_MS 5000
+#define GRACE_MS 500
+#define POLL_MS 20
+
+static volatile int64_t waiter_result;
+static volatile uint8_t waiter_done;
+
+uint64_t sem_destroy_waiter(uint64_t argc, char *argv[])
+{
+  uint64_t timeout = argc > 0 ? (uint64_t)satoi(argv[0]) : 0;
+
+  if (timeout > 0)
+    waiter_result = sys_sem_timedwait(SEM_ID, timeout);
+  else
+    waiter_result = sys_sem_wait(SEM_ID);
+
+  waiter_done = 1;
+  return 0;
+}
+
+// Destroys the semaphore under a blocked waiter, which must come back with -1 well before its own timeout.
+static int run_case(const char *name, char *timeout)
+{
+  int16_t default_fds[3] = {STDIN, STDOUT, STDERR};
+  char *args[] = {timeout, NULL};
+
+  waiter_result = 0;
+  waiter_done = 0;
+
+  if (sys_sem_init(SEM_ID, 0) < 0)
+  {
+    puts("test_sem_destroy: ERROR creating semaphore\n");
+    return -1;
+  }
+
+  int64_t pid = sys_create_process((uint64_t)&sem_destroy_waiter, (uint64_t)args, (uint64_t)"sem_waiter", 2, (uint64_t)default_fds);
+  if (pid < 0)
+  {
+    puts("test_sem_destroy: ERROR creating waiter\n");
+    sys_sem_destroy(SEM_ID);
+    return -1;
+  }
+
+  sys_sleep_ms(GRACE_MS);
+  sys_sem_destroy(SEM_ID);
+
+  for (int waited = 0; !waiter_done && waited < GRACE_MS; waited += POLL_MS)
+    sys_sleep_ms(POLL_MS);
+
+  int ok = waiter_done && waiter_result == -1;
+  if (!waiter_done)
+    sys_kill_process((uint64_t)pid, 0);
+  sys_waitpid((uint64_t)pid);
+
+  puts(name);
+  puts(ok ? ": OK\n" : ": FAILED\n");
+  return ok ? 0 : -1;
+}
+
+uint64_t test_sem_destroy(uint64_t argc, char *argv[])
+{
+  char timeout[12];
+  itoa((int)(WAITER_TIMEOUT_MS * kernel_info()->tick_hz / 1000), timeout);
+
+  int failed = 0;
+  failed |= run_case("sem_wait on a destroyed semaphore", "0");
+  failed |= run_case("sem_timedwait on a destroyed semaphore", timeout);
+
+  return failed ? -1 : 0;
+}
@@ -7,12 +7,20 @@
 #include "stdio.h"
 #include "stdlib.h"
 #include "unistd.h"
+#include "sync.h"
 #include "test_util.h"
 
 #define SEM_ID 67
 #define TOTAL_PAIR_PROCESSES 2
 
+#define USE_SEMAPHORE 1
+#define USE_FUTEX 2
+#define USE_INHERIT_MUTEX 3
+
+#define USES_KERNEL_SEM(mode) ((mode) == USE_SEMAPHORE || (mode) == USE_INHERIT_MUTEX)
+
 int64_t global;  
+static mutex_t futex_mutex;
 
 void slowInc(int64_t *p, int64_t inc)
 {
@@ -38,7 +46,7 @@ uint64_t my_process_inc(uint64_t argc, char *argv[])
   if ((use_sem = satoi(argv[2])) < 0)
     return -1;
 
-  if (use_sem)
+  if (USES_KERNEL_SEM(use_sem))
     if (sys_sem_open(SEM_ID) < 0)
     {
       puts("test_sync: ERROR opening semaphore\n");
@@ -48,7 +56,7 @@ uint64_t my_process_inc(uint64_t argc, char *argv[])
   uint64_t i;
   for (i = 0; i < n; i++)
   {
-    if (use_sem)
+    if (USES_KERNEL_SEM(use_sem))
     {
       if (sys_sem_wait(SEM_ID) < 0)
       {
@@ -56,8 +64,10 @@ uint64_t my_process_inc(uint64_t argc, char *argv[])
         return -1;
       }
     }
+    else if (use_sem == USE_FUTEX)
+      mutex_lock(&futex_mutex);
     slowInc(&global, inc);
-    if (use_sem)
+    if (USES_KERNEL_SEM(use_sem))
     {
       if (sys_sem_post(SEM_ID) < 0)
       {
@@ -65,9 +75,11 @@ uint64_t my_process_inc(uint64_t argc, char *argv[])
         return -1;
       }
     }
+    else if (use_sem == USE_FUTEX)
+      mutex_unlock(&futex_mutex);
   }
 
-  if (use_sem)
+  if (USES_KERNEL_SEM(use_sem))
     sys_sem_close(SEM_ID);
 
   return 0;
@@ -82,9 +94,12 @@ uint64_t test_sync(uint64_t argc, char *argv[])
 
    
   int8_t useSem = satoi(argv[1]);
-  if (useSem)
+  if (useSem == USE_FUTEX)
+    mutex_init(&futex_mutex);
+  if (USES_KERNEL_SEM(useSem))
   {
-    if (sys_sem_init(SEM_ID, 1) < 0)
+    int64_t created = useSem == USE_INHERIT_MUTEX ? sys_sem_init_mutex(SEM_ID) : sys_sem_init(SEM_ID, 1);
+    if (created < 0)
     {
       puts("test_sync: ERROR creating semaphore\n");
       return -1;
@@ -105,7 +120,7 @@ uint64_t test_sync(uint64_t argc, char *argv[])
     if (pids[i] < 0)
     {
       puts("test_sync: ERROR creating decrement process\n");
-      if (useSem)
+      if (USES_KERNEL_SEM(useSem))
         sys_sem_destroy(SEM_ID);
       return -1;
     }
@@ -113,7 +128,7 @@ uint64_t test_sync(uint64_t argc, char *argv[])
     if (pids[i + TOTAL_PAIR_PROCESSES] < 0)
     {
       puts("test_sync: ERROR creating increment process\n");
-      if (useSem)
+      if (USES_KERNEL_SEM(useSem))
         sys_sem_destroy(SEM_ID);
       return -1;
     }
@@ -132,7 +147,7 @@ uint64_t test_sync(uint64_t argc, char *argv[])
   }
 
    
-  if (useSem)
+  if (USES_KERNEL_SEM(useSem))
   {
     sys_sem_destroy(SEM_ID);
   }